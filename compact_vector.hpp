@@ -0,0 +1,527 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "util/enable_if.hpp"
+#include "util/equal.hpp"
+#include "util/growth_policy.hpp"
+#include "util/integral_constant.hpp"
+#include "util/is_integral.hpp"
+#include "util/is_trivially_relocatable.hpp"
+#include "util/iterator_traits.hpp"
+#include "util/lexicographical_compare.hpp"
+#include "util/reverse_iterator.hpp"
+#include "util/uninitialized_transfer.hpp"
+#include "util/wrap_iter.hpp"
+
+namespace ft {
+
+// Layouts of compact_vector. Each header derives from the allocator so that a
+// stateless one takes no space, and keeps the block pointer and the 32-bit
+// size and capacity of the elements; counts written while there is no block
+// must be zero.
+
+// The pointer and both counts live in the vector: 16 bytes on LP64.
+struct counts_in_header {
+    template <class T, class Allocator>
+    class header : public Allocator {
+    public:
+        typedef typename Allocator::pointer pointer;
+        typedef typename Allocator::size_type size_type;
+        typedef unsigned int count_type;
+
+        explicit header(const Allocator& alloc) : Allocator(alloc), begin_(NULL), size_(0), cap_(0) {}
+
+        pointer begin() const { return begin_; }
+        count_type size() const { return size_; }
+        count_type capacity() const { return cap_; }
+        void set_size(count_type n) { size_ = n; }
+
+        void adopt(pointer p, count_type size, count_type cap) {
+            begin_ = p;
+            size_ = size;
+            cap_ = cap;
+        }
+
+        pointer allocate_block(size_type n) { return this->allocate(n); }
+        void deallocate_block(pointer p, size_type n) { this->deallocate(p, n); }
+
+    private:
+        pointer begin_;
+        count_type size_;
+        count_type cap_;
+    };
+};
+
+// Only the pointer lives in the vector: 8 bytes on LP64. The counts sit in a
+// prefix of the block, one unit of max(8, alignof(T)) bytes so the elements
+// after it stay aligned, and an empty vector owns no block at all. Every
+// size update is then a store through the pointer, and a non-empty block
+// costs the prefix on top of the elements.
+struct counts_in_block {
+    template <class T, class Allocator>
+    class header : public Allocator {
+    public:
+        typedef typename Allocator::pointer pointer;
+        typedef typename Allocator::size_type size_type;
+        typedef unsigned int count_type;
+
+        explicit header(const Allocator& alloc) : Allocator(alloc), begin_(NULL) {}
+
+        pointer begin() const { return begin_; }
+        count_type size() const { return begin_ == NULL ? 0 : counts()->size; }
+        count_type capacity() const { return begin_ == NULL ? 0 : counts()->cap; }
+
+        void set_size(count_type n) {
+            if (begin_ != NULL) {
+                counts()->size = n;
+            }
+        }
+
+        void adopt(pointer p, count_type size, count_type cap) {
+            begin_ = p;
+            if (p != NULL) {
+                counts()->size = size;
+                counts()->cap = cap;
+            }
+        }
+
+        pointer allocate_block(size_type n) {
+            unit* u = unit_allocator(*this).allocate(units(n));
+            ::new (static_cast<void*>(u)) block_counts();
+            return reinterpret_cast<pointer>(u + 1);
+        }
+
+        void deallocate_block(pointer p, size_type n) {
+            unit_allocator(*this).deallocate(reinterpret_cast<unit*>(p) - 1, units(n));
+        }
+
+    private:
+        struct block_counts {
+            count_type size;
+            count_type cap;
+        };
+
+        static const size_type unit_size = __alignof__(T) > sizeof(block_counts) ? __alignof__(T) : sizeof(block_counts);
+
+        struct unit {
+            char bytes[unit_size];
+        } __attribute__((__aligned__(unit_size)));
+
+        typedef typename Allocator::template rebind<unit>::other unit_allocator;
+
+        static size_type units(size_type n) {
+            return 1 + (n * sizeof(T) + unit_size - 1) / unit_size;
+        }
+
+        block_counts* counts() const {
+            return reinterpret_cast<block_counts*>(reinterpret_cast<unit*>(begin_) - 1);
+        }
+
+        pointer begin_;
+    };
+};
+
+// A vector whose header is one pointer and two 32-bit counts: 16 bytes
+// instead of vector's 24 on LP64, for containers holding many short vectors,
+// or 8 bytes with Layout = counts_in_block. It keeps vector's interface, but
+// can hold at most 2^32 - 1 elements.
+template <class T, class Allocator = std::allocator<T>, class Layout = counts_in_header>
+class compact_vector {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef wrap_iter<pointer> iterator;
+    typedef wrap_iter<const_pointer> const_iterator;
+    typedef ft::reverse_iterator<iterator> reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    typedef typename Layout::template header<value_type, allocator_type> header;
+    typedef typename header::count_type count_type;
+
+    header h_;
+
+public:
+    explicit compact_vector(const allocator_type& alloc = allocator_type()) : h_(alloc) {}
+
+    explicit compact_vector(size_type n, const value_type& val = value_type(),
+                            const allocator_type& alloc = allocator_type())
+        : h_(alloc)
+    {
+        try {
+            insert(end(), n, val);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    template <class InputIterator>
+    compact_vector(InputIterator first, InputIterator last,
+                   const allocator_type& alloc = allocator_type(),
+                   typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : h_(alloc)
+    {
+        try {
+            insert(end(), first, last);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    compact_vector(const compact_vector& x) : h_(x.get_allocator()) {
+        try {
+            insert(end(), x.begin(), x.end());
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    compact_vector& operator=(const compact_vector& x) {
+        if (this != &x) {
+            assign(x.begin(), x.end());
+        }
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    compact_vector(compact_vector&& x) noexcept : h_(x.h_) {
+        x.h_.adopt(NULL, 0, 0);
+    }
+
+    compact_vector& operator=(compact_vector&& x) noexcept {
+        if (this != &x) {
+            vdeallocate();
+            h_ = x.h_;
+            x.h_.adopt(NULL, 0, 0);
+        }
+        return *this;
+    }
+#endif
+
+    ~compact_vector() {
+        vdeallocate();
+    }
+
+    iterator begin() { return h_.begin(); }
+    const_iterator begin() const { return h_.begin(); }
+    iterator end() { return h_.begin() + h_.size(); }
+    const_iterator end() const { return h_.begin() + h_.size(); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return h_.size(); }
+    size_type capacity() const { return h_.capacity(); }
+    size_type max_size() const { return std::min<size_type>(h_.max_size(), static_cast<count_type>(-1)); }
+    bool empty() const { return h_.size() == 0; }
+
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            if (n > max_size()) {
+                throw std::length_error("compact_vector");
+            }
+            pointer p = h_.allocate_block(n);
+            relocate_to(p, n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (capacity() > size()) {
+            try {
+                if (empty()) {
+                    vdeallocate();
+                } else {
+                    relocate_to(h_.allocate_block(size()), size());
+                }
+            } catch (...) {
+            }
+        }
+    }
+
+    void resize(size_type n, value_type val = value_type()) {
+        if (n < size()) {
+            destruct_at_end(n);
+        } else {
+            insert(end(), n - size(), val);
+        }
+    }
+
+    reference operator[](size_type n) { return h_.begin()[n]; }
+    const_reference operator[](size_type n) const { return h_.begin()[n]; }
+
+    reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("compact_vector");
+        }
+        return h_.begin()[n];
+    }
+
+    const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("compact_vector");
+        }
+        return h_.begin()[n];
+    }
+
+    reference front() { return *h_.begin(); }
+    const_reference front() const { return *h_.begin(); }
+    reference back() { return h_.begin()[h_.size() - 1]; }
+    const_reference back() const { return h_.begin()[h_.size() - 1]; }
+
+    pointer data() { return h_.begin(); }
+    const_pointer data() const { return h_.begin(); }
+
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    assign(InputIterator first, InputIterator last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(size_type n, const value_type& val) {
+        value_type tmp(val);
+        clear();
+        insert(end(), n, tmp);
+    }
+
+    void push_back(const value_type& val) {
+        if (size() != capacity()) {
+            h_.construct(h_.begin() + size(), val);
+            h_.set_size(h_.size() + 1);
+        } else {
+            // Built in the new block first, since val may live in the old one.
+            size_type n = recommend(size() + 1);
+            pointer p = h_.allocate_block(n);
+            try {
+                h_.construct(p + size(), val);
+            } catch (...) {
+                h_.deallocate_block(p, n);
+                throw;
+            }
+            relocate_to(p, n, 1);
+        }
+    }
+
+#if __cplusplus >= 201103L
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        if (size() == capacity()) {
+            value_type tmp(std::forward<Args>(args)...);
+            reserve(recommend(size() + 1));
+            ::new (static_cast<void*>(h_.begin() + size())) value_type(std::move(tmp));
+        } else {
+            ::new (static_cast<void*>(h_.begin() + size())) value_type(std::forward<Args>(args)...);
+        }
+        h_.set_size(h_.size() + 1);
+    }
+
+    void push_back(value_type&& val) {
+        emplace_back(std::move(val));
+    }
+#endif
+
+    void pop_back() {
+        destruct_at_end(size() - 1);
+    }
+
+    iterator insert(iterator position, const value_type& val) {
+        difference_type d = position - begin();
+        insert(position, 1, val);
+        return begin() + d;
+    }
+
+    // New elements are constructed at the end and rotated into place.
+    void insert(iterator position, size_type n, const value_type& val) {
+        if (n == 0) {
+            return;
+        }
+        size_type d = static_cast<size_type>(position - begin());
+        size_type old_size = size();
+        value_type tmp(val);
+        if (n > capacity() - old_size) {
+            reserve(recommend(old_size + n));
+        }
+        try {
+            for (; n > 0; --n) {
+                h_.construct(h_.begin() + size(), tmp);
+                h_.set_size(h_.size() + 1);
+            }
+        } catch (...) {
+            destruct_at_end(old_size);
+            throw;
+        }
+        std::rotate(h_.begin() + d, h_.begin() + old_size, h_.begin() + size());
+    }
+
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    insert(iterator position, InputIterator first, InputIterator last) {
+        size_type d = static_cast<size_type>(position - begin());
+        size_type old_size = size();
+        insert_range(first, last, typename iterator_traits<InputIterator>::iterator_category());
+        std::rotate(h_.begin() + d, h_.begin() + old_size, h_.begin() + size());
+    }
+
+    iterator erase(iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        size_type d = static_cast<size_type>(first - begin());
+        if (first != last) {
+            pointer p = std::copy(h_.begin() + (last - begin()), h_.begin() + size(), h_.begin() + d);
+            destruct_at_end(static_cast<size_type>(p - h_.begin()));
+        }
+        return begin() + d;
+    }
+
+    void swap(compact_vector& x) {
+        std::swap(h_, x.h_);
+    }
+
+    void clear() {
+        destruct_at_end(0);
+    }
+
+    allocator_type get_allocator() const {
+        return h_;
+    }
+
+private:
+    size_type recommend(size_type n) const {
+        size_type ms = max_size();
+        if (n > ms) {
+            throw std::length_error("compact_vector");
+        }
+        return vector_growth<value_type, allocator_type>::template recommend<value_type>(capacity(), n, ms);
+    }
+
+    template <class InputIterator>
+    void insert_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+        size_type old_size = size();
+        try {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        } catch (...) {
+            destruct_at_end(old_size);
+            throw;
+        }
+    }
+
+    template <class ForwardIterator>
+    void insert_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        size_type old_size = size();
+        if (n > capacity() - old_size) {
+            reserve(recommend(old_size + n));
+        }
+        try {
+            for (; first != last; ++first) {
+                h_.construct(h_.begin() + size(), *first);
+                h_.set_size(h_.size() + 1);
+            }
+        } catch (...) {
+            destruct_at_end(old_size);
+            throw;
+        }
+    }
+
+    // Moves the elements into the block p of cap elements, whose slots past
+    // them already hold extra constructed elements, and frees the old block.
+    void relocate_to(pointer p, size_type cap, size_type extra = 0) {
+        count_type n = static_cast<count_type>(size() + extra);
+        move_elements(p, cap, extra, is_trivially_relocatable<value_type>());
+        h_.adopt(p, n, static_cast<count_type>(cap));
+    }
+
+    void move_elements(pointer p, size_type, size_type, true_type) {
+        if (h_.begin() != NULL) {
+            std::memcpy(static_cast<void*>(p), static_cast<const void*>(h_.begin()), size() * sizeof(value_type));
+            h_.deallocate_block(h_.begin(), capacity());
+        }
+    }
+
+    void move_elements(pointer p, size_type cap, size_type extra, false_type) {
+        try {
+            uninitialized_transfer(h_.begin(), h_.begin() + size(), p);
+        } catch (...) {
+            for (size_type j = size(); j < size() + extra; ++j) {
+                h_.destroy(p + j);
+            }
+            h_.deallocate_block(p, cap);
+            throw;
+        }
+        vdeallocate();
+    }
+
+    void destruct_at_end(size_type n) {
+        for (count_type sz = h_.size(); sz > n; ) {
+            h_.destroy(h_.begin() + --sz);
+            h_.set_size(sz);
+        }
+    }
+
+    void vdeallocate() {
+        if (h_.begin() != NULL) {
+            clear();
+            h_.deallocate_block(h_.begin(), capacity());
+            h_.adopt(NULL, 0, 0);
+        }
+    }
+};
+
+template <class T, class Allocator, class Layout>
+inline bool operator==(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator, class Layout>
+inline bool operator!=(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return !(x == y);
+}
+
+template <class T, class Allocator, class Layout>
+inline bool operator<(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, class Allocator, class Layout>
+inline bool operator>(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return y < x;
+}
+
+template <class T, class Allocator, class Layout>
+inline bool operator<=(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return !(y < x);
+}
+
+template <class T, class Allocator, class Layout>
+inline bool operator>=(const compact_vector<T, Allocator, Layout>& x, const compact_vector<T, Allocator, Layout>& y) {
+    return !(x < y);
+}
+
+template <class T, class Allocator, class Layout>
+inline void swap(compact_vector<T, Allocator, Layout>& x, compact_vector<T, Allocator, Layout>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <stdint.h>
+
+#include "concurrent_vector.hpp"
+#include "util/atomic.hpp"
+
+namespace {
+
+// Small number of the calling thread, handed out in order of first use.
+inline unsigned thread_number() {
+    static unsigned next = 0;
+    static __thread unsigned number = 0;
+    if (number == 0) {
+        number = atomic_fetch_add(&next, 1u) + 1;
+    }
+    return number - 1;
+}
+
+} // anonymous namespace
+
+namespace ft {
+
+// Lock-free LIFO for any number of pushing and popping threads (a Treiber
+// stack). Nodes live in a concurrent_vector and are named by 32-bit index;
+// the head packs that index with a 32-bit tag bumped on every update, so a
+// compare-and-swap fails if the head was popped and pushed back in between
+// (the ABA problem). Popped nodes go to free lists of the same kind and are
+// reused, so steady-state pushes do not allocate. There is one free list per
+// thread, up to free_lists threads, each on its own cache line; a thread
+// whose list is empty takes nodes from the others before it allocates. Node
+// memory is only freed with the stack, which keeps reads of a just-popped
+// node safe.
+template <class T, class Allocator = std::allocator<T> >
+class concurrent_stack {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::const_reference const_reference;
+
+private:
+    typedef uint32_t index_type;
+    typedef uint64_t head_type;
+
+    static const unsigned free_lists = 16;
+
+    struct node {
+        // 1-based index of the next node, 0 at the bottom.
+        index_type next;
+        char buf[sizeof(T)] __attribute__((__aligned__(__alignof__(T))));
+
+        node() : next(0) {}
+        node(const node&) : next(0) {}
+
+        T* value() { return reinterpret_cast<T*>(buf); }
+    };
+
+    typedef typename allocator_type::template rebind<node>::other node_allocator;
+
+    // Every head sits on its own cache line.
+    struct padded_head {
+        head_type head;
+        char pad[64 - sizeof(head_type)];
+    };
+
+    head_type top_;
+    char pad_[64 - sizeof(head_type)];
+    padded_head free_[free_lists];
+    allocator_type alloc_;
+    concurrent_vector<node, node_allocator> nodes_;
+
+    concurrent_stack(const concurrent_stack&);
+    concurrent_stack& operator=(const concurrent_stack&);
+
+public:
+    explicit concurrent_stack(const allocator_type& alloc = allocator_type())
+        : top_(0)
+        , alloc_(alloc)
+        , nodes_(node_allocator(alloc))
+    {
+        for (unsigned k = 0; k < free_lists; ++k) {
+            free_[k].head = 0;
+        }
+    }
+
+    // Not thread-safe: no other thread may use the stack any more.
+    ~concurrent_stack() {
+        for (index_type i = index_of(top_); i != 0; i = at(i).next) {
+            alloc_.destroy(at(i).value());
+        }
+    }
+
+    // A snapshot: another thread may push or pop right after.
+    bool empty() const {
+        return index_of(atomic_load_acquire(&top_)) == 0;
+    }
+
+    void push(const value_type& val) {
+        index_type i = take_nodes(1);
+        try {
+            alloc_.construct(at(i).value(), val);
+        } catch (...) {
+            push_chain(own_free_list(), i, i);
+            throw;
+        }
+        push_chain(&top_, i, i);
+    }
+
+    // Pushes [first, last) as if one at a time, with a single update of the
+    // head, so the other threads see all of it or none of it.
+    template <class ForwardIterator>
+    void push_batch(ForwardIterator first, ForwardIterator last) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n == 0) {
+            return;
+        }
+        // Fills the nodes of rest in order and links them in reverse, so the
+        // last value ends up on top.
+        index_type rest = take_nodes(n);
+        index_type bottom = rest;
+        index_type top = 0;
+        try {
+            for (; first != last; ++first) {
+                index_type i = rest;
+                alloc_.construct(at(i).value(), *first);
+                rest = at(i).next;
+                atomic_store_relaxed(&at(i).next, top);
+                top = i;
+            }
+        } catch (...) {
+            for (index_type i = top; i != 0; i = at(i).next) {
+                alloc_.destroy(at(i).value());
+            }
+            if (top != 0) {
+                push_chain(own_free_list(), top, bottom);
+            }
+            push_chain(own_free_list(), rest, last_of(rest));
+            throw;
+        }
+        push_chain(&top_, top, bottom);
+    }
+
+    // Pops the top element into val, or returns false if the stack is empty.
+    bool try_pop(value_type& val) {
+        index_type i = pop_head(&top_);
+        if (i == 0) {
+            return false;
+        }
+        // If the assignment throws, the element goes back on top.
+        T* p = at(i).value();
+        try {
+#if __cplusplus >= 201103L
+            val = std::move_if_noexcept(*p);
+#else
+            val = *p;
+#endif
+        } catch (...) {
+            push_chain(&top_, i, i);
+            throw;
+        }
+        alloc_.destroy(p);
+        push_chain(own_free_list(), i, i);
+        return true;
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    static index_type index_of(head_type h) {
+        return static_cast<index_type>(h);
+    }
+
+    static head_type make_head(index_type i, head_type old) {
+        return ((old >> 32) + 1) << 32 | i;
+    }
+
+    head_type* own_free_list() {
+        return &free_[thread_number() % free_lists].head;
+    }
+
+    // Pops a node from the calling thread's free list, else from another's.
+    index_type pop_free() {
+        unsigned own = thread_number() % free_lists;
+        for (unsigned k = 0; k < free_lists; ++k) {
+            index_type i = pop_head(&free_[(own + k) % free_lists].head);
+            if (i != 0) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    node& at(index_type i) {
+        return nodes_[i - 1];
+    }
+
+    // Links [first, last] (already chained through next) on top of head.
+    void push_chain(head_type* head, index_type first, index_type last) {
+        head_type old = atomic_load_relaxed(head);
+        do {
+            atomic_store_relaxed(&at(last).next, index_of(old));
+        } while (!atomic_compare_exchange(head, &old, make_head(first, old)));
+    }
+
+    index_type pop_head(head_type* head) {
+        head_type old = atomic_load_acquire(head);
+        while (index_of(old) != 0) {
+            index_type next = atomic_load_relaxed(&at(index_of(old)).next);
+            if (atomic_compare_exchange(head, &old, make_head(next, old))) {
+                return index_of(old);
+            }
+        }
+        return 0;
+    }
+
+    // Returns a chain of n unused nodes linked through next and ending in 0,
+    // reusing freed nodes first and growing the node array for the rest.
+    index_type take_nodes(size_type n) {
+        index_type head = 0;
+        for (; n > 0; --n) {
+            index_type i = pop_free();
+            if (i == 0) {
+                break;
+            }
+            atomic_store_relaxed(&at(i).next, head);
+            head = i;
+        }
+        if (n > 0) {
+            index_type first = static_cast<index_type>(nodes_.grow_by(n) - nodes_.begin()) + 1;
+            for (index_type i = first; i < first + n - 1; ++i) {
+                atomic_store_relaxed(&at(i).next, i + 1);
+            }
+            atomic_store_relaxed(&at(first + n - 1).next, head);
+            head = first;
+        }
+        return head;
+    }
+
+    index_type last_of(index_type i) {
+        while (at(i).next != 0) {
+            i = at(i).next;
+        }
+        return i;
+    }
+};
+
+} // namespace ft
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+
+#include "util/atomic.hpp"
+#include "util/index_iterator.hpp"
+#include "util/reverse_iterator.hpp"
+
+namespace ft {
+
+// Grow-only vector that any number of threads may append to concurrently.
+// Storage is a table of segments of 8, 16, 32, ... elements, so elements never
+// move once constructed. Appending threads claim slots with one fetch-add,
+// construct them in parallel and mark each slot ready in a per-segment flag
+// array. Whichever thread then finds the slots at size() ready advances size()
+// past them, so an append never waits for another one and size() is always a
+// prefix that readers can index without locking. clear(), copying and
+// destruction are not thread-safe.
+//
+// The copy constructor of value_type and the allocator must not throw once
+// slots are claimed: a claimed slot that never becomes ready would hide every
+// later element, so such a failure terminates the program.
+template <class T, class Allocator = std::allocator<T> >
+class concurrent_vector {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef index_iterator<concurrent_vector, value_type> iterator;
+    typedef index_iterator<const concurrent_vector, const value_type> const_iterator;
+    typedef ft::reverse_iterator<iterator> reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    typedef typename allocator_type::template rebind<char>::other flag_allocator;
+
+    static const size_type first_segment_bits = 3;
+    static const size_type first_segment_size = static_cast<size_type>(1) << first_segment_bits;
+    static const size_type max_segments = sizeof(size_type) * 8 - first_segment_bits;
+
+    allocator_type alloc_;
+    pointer segments_[max_segments];
+    char* ready_[max_segments];
+    size_type claimed_;
+    size_type published_;
+
+public:
+    explicit concurrent_vector(const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , claimed_(0)
+        , published_(0)
+    {
+        for (size_type k = 0; k < max_segments; ++k) {
+            segments_[k] = NULL;
+            ready_[k] = NULL;
+        }
+    }
+
+    concurrent_vector(const concurrent_vector& x)
+        : alloc_(x.alloc_)
+        , claimed_(0)
+        , published_(0)
+    {
+        for (size_type k = 0; k < max_segments; ++k) {
+            segments_[k] = NULL;
+            ready_[k] = NULL;
+        }
+        try {
+            append(x);
+        } catch (...) {
+            deallocate_all();
+            throw;
+        }
+    }
+
+    concurrent_vector& operator=(const concurrent_vector& x) {
+        if (this != &x) {
+            clear();
+            append(x);
+        }
+        return *this;
+    }
+
+    ~concurrent_vector() {
+        deallocate_all();
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Number of published elements; every index below it is safe to read.
+    size_type size() const { return atomic_load_acquire(&published_); }
+    bool empty() const { return size() == 0; }
+    size_type max_size() const { return alloc_.max_size(); }
+
+    reference operator[](size_type n) { return slot(n); }
+    const_reference operator[](size_type n) const { return slot(n); }
+
+    reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("concurrent_vector");
+        }
+        return slot(n);
+    }
+
+    const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("concurrent_vector");
+        }
+        return slot(n);
+    }
+
+    iterator push_back(const value_type& val) {
+        return grow_by(1, val);
+    }
+
+    // Appends n copies of val and returns an iterator to the first of them.
+    iterator grow_by(size_type n, const value_type& val = value_type()) {
+        size_type first = atomic_fetch_add(&claimed_, n);
+        try {
+            for (size_type i = first; i < first + n; ++i) {
+                alloc_.construct(&claim_slot(i), val);
+                atomic_store_release(&ready_flag(i), static_cast<char>(1));
+            }
+        } catch (...) {
+            std::terminate();
+        }
+        publish();
+        return iterator(this, first);
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+    void clear() {
+        size_type n = size();
+        for (size_type i = 0; i < n; ++i) {
+            alloc_.destroy(&slot(i));
+            ready_flag(i) = 0;
+        }
+        claimed_ = published_ = 0;
+    }
+
+private:
+    static size_type segment_index(size_type i) {
+        return sizeof(unsigned long) * 8 - 1 - __builtin_clzl(static_cast<unsigned long>(i + first_segment_size))
+               - first_segment_bits;
+    }
+
+    static size_type segment_base(size_type k) {
+        return (first_segment_size << k) - first_segment_size;
+    }
+
+    static size_type segment_size(size_type k) {
+        return first_segment_size << k;
+    }
+
+    reference slot(size_type i) const {
+        size_type k = segment_index(i);
+        return atomic_load_relaxed(&segments_[k])[i - segment_base(k)];
+    }
+
+    char& ready_flag(size_type i) const {
+        size_type k = segment_index(i);
+        return atomic_load_relaxed(&ready_[k])[i - segment_base(k)];
+    }
+
+    bool is_ready(size_type i) const {
+        size_type k = segment_index(i);
+        char* flags = atomic_load_acquire(&ready_[k]);
+        return flags != NULL && atomic_load_acquire(&flags[i - segment_base(k)]) != 0;
+    }
+
+    // Returns slot i, allocating its segment and ready flags if no other
+    // thread has yet.
+    reference claim_slot(size_type i) {
+        size_type k = segment_index(i);
+        if (atomic_load_acquire(&ready_[k]) == NULL) {
+            flag_allocator fa(alloc_);
+            char* fresh = fa.allocate(segment_size(k));
+            std::memset(fresh, 0, segment_size(k));
+            char* expected = NULL;
+            if (!atomic_compare_exchange(&ready_[k], &expected, fresh)) {
+                fa.deallocate(fresh, segment_size(k));
+            }
+        }
+        pointer seg = atomic_load_acquire(&segments_[k]);
+        if (seg == NULL) {
+            pointer fresh = alloc_.allocate(segment_size(k));
+            if (atomic_compare_exchange(&segments_[k], &seg, fresh)) {
+                seg = fresh;
+            } else {
+                alloc_.deallocate(fresh, segment_size(k));
+            }
+        }
+        return seg[i - segment_base(k)];
+    }
+
+    // Advances published_ over every ready slot at its end. The fence pairs
+    // with the one of any other appender, so that of two threads marking
+    // slots at the same time at least one sees both and publishes them.
+    void publish() {
+        atomic_fence();
+        size_type p = atomic_load_acquire(&published_);
+        for (;;) {
+            size_type q = p;
+            while (is_ready(q)) {
+                ++q;
+            }
+            if (q == p || atomic_compare_exchange(&published_, &p, q)) {
+                return;
+            }
+        }
+    }
+
+    void append(const concurrent_vector& x) {
+        size_type n = x.size();
+        for (size_type i = 0; i < n; ++i) {
+            alloc_.construct(&claim_slot(claimed_), x[i]);
+            ready_flag(claimed_) = 1;
+            published_ = ++claimed_;
+        }
+    }
+
+    void deallocate_all() {
+        clear();
+        for (size_type k = 0; k < max_segments; ++k) {
+            if (segments_[k] != NULL) {
+                alloc_.deallocate(segments_[k], segment_size(k));
+                segments_[k] = NULL;
+            }
+            if (ready_[k] != NULL) {
+                flag_allocator(alloc_).deallocate(ready_[k], segment_size(k));
+                ready_[k] = NULL;
+            }
+        }
+    }
+};
+
+} // namespace ft
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+#include "util/enable_if.hpp"
+#include "util/integral_constant.hpp"
+#include "util/is_integral.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+template <class T>
+class delta_vector;
+
+// Forward iterator that decodes one delta per step.
+template <class T>
+class delta_vector_iterator {
+private:
+    const delta_vector<T>* c;
+    std::size_t i;
+    std::size_t pos;
+    T val;
+
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef T reference;
+
+    delta_vector_iterator() : c(NULL), i(0), pos(0), val() {}
+
+    delta_vector_iterator(const delta_vector<T>* c, std::size_t i) : c(c), i(i), pos(0), val() {
+        if (i < c->size()) {
+            c->seek(i, pos, val);
+        }
+    }
+
+    reference operator*() const { return val; }
+    pointer operator->() const { return &val; }
+
+    delta_vector_iterator& operator++() {
+        if (++i < c->size()) {
+            c->step(i, pos, val);
+        }
+        return *this;
+    }
+
+    delta_vector_iterator operator++(int) {
+        delta_vector_iterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    friend bool operator==(const delta_vector_iterator& x, const delta_vector_iterator& y) { return x.i == y.i; }
+    friend bool operator!=(const delta_vector_iterator& x, const delta_vector_iterator& y) { return x.i != y.i; }
+};
+
+// Integer sequence stored in blocks of block_size values: the first value of
+// each block in full, the rest as zigzag varint deltas to their predecessor.
+// Sorted or nearly sorted IDs take one or two bytes each. Iteration decodes
+// sequentially; operator[] decodes from the start of the element's block.
+template <class T>
+class delta_vector {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type const_reference;
+    typedef delta_vector_iterator<T> const_iterator;
+    typedef const_iterator iterator;
+
+    static const size_type block_size = 128;
+
+private:
+    typedef char integral_only[is_integral<T>::value ? 1 : -1];
+    typedef unsigned long word_type;
+
+    vector<value_type> firsts_;
+    vector<size_type> offsets_;
+    vector<unsigned char> bytes_;
+    size_type size_;
+    value_type last_;
+
+public:
+    delta_vector() : size_(0), last_() {}
+
+    template <class InputIterator>
+    delta_vector(InputIterator first, InputIterator last,
+                 typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : size_(0)
+        , last_()
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    value_type operator[](size_type n) const {
+        size_type pos;
+        value_type val;
+        seek(n, pos, val);
+        return val;
+    }
+
+    value_type at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range("delta_vector");
+        }
+        return (*this)[n];
+    }
+
+    value_type front() const { return firsts_[0]; }
+    value_type back() const { return last_; }
+
+    void push_back(value_type val) {
+        if (size_ % block_size == 0) {
+            firsts_.push_back(val);
+            offsets_.push_back(bytes_.size());
+        } else {
+            word_type d = static_cast<word_type>(val) - static_cast<word_type>(last_);
+            word_type z = (d << 1) ^ static_cast<word_type>(-static_cast<long>(d >> (sizeof(word_type) * 8 - 1)));
+            for (; z >= 0x80; z >>= 7) {
+                bytes_.push_back(static_cast<unsigned char>(z | 0x80));
+            }
+            bytes_.push_back(static_cast<unsigned char>(z));
+        }
+        last_ = val;
+        ++size_;
+    }
+
+    void pop_back() {
+        --size_;
+        if (size_ % block_size == 0) {
+            bytes_.resize(offsets_.back());
+            firsts_.pop_back();
+            offsets_.pop_back();
+            if (size_ > 0) {
+                last_ = (*this)[size_ - 1];
+            }
+        } else {
+            size_type p = bytes_.size() - 1;
+            while (p > offsets_.back() && (bytes_[p - 1] & 0x80)) {
+                --p;
+            }
+            bytes_.resize(p);
+            last_ = (*this)[size_ - 1];
+        }
+    }
+
+    void clear() {
+        firsts_.clear();
+        offsets_.clear();
+        bytes_.clear();
+        size_ = 0;
+    }
+
+    void swap(delta_vector& x) {
+        firsts_.swap(x.firsts_);
+        offsets_.swap(x.offsets_);
+        bytes_.swap(x.bytes_);
+        std::swap(size_, x.size_);
+        std::swap(last_, x.last_);
+    }
+
+    // Writes the values of block b to out and returns how many there are.
+    size_type decode_block(size_type b, value_type* out) const {
+        size_type first = b * block_size;
+        size_type n = size_ - first < block_size ? size_ - first : block_size;
+        size_type pos = offsets_[b];
+        value_type val = firsts_[b];
+        out[0] = val;
+        for (size_type i = 1; i < n; ++i) {
+            val = next(pos, val);
+            out[i] = val;
+        }
+        return n;
+    }
+
+    size_type block_count() const { return firsts_.size(); }
+
+    // Bytes of encoded data, not counting the block tables' slack.
+    size_type encoded_bytes() const {
+        return bytes_.size() + firsts_.size() * (sizeof(value_type) + sizeof(size_type));
+    }
+
+private:
+    friend class delta_vector_iterator<T>;
+
+    value_type next(size_type& pos, value_type val) const {
+        word_type z = 0;
+        unsigned shift = 0;
+        unsigned char b;
+        do {
+            b = bytes_[pos++];
+            z |= static_cast<word_type>(b & 0x7f) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        word_type d = (z >> 1) ^ static_cast<word_type>(-static_cast<long>(z & 1));
+        return static_cast<value_type>(static_cast<word_type>(val) + d);
+    }
+
+    // Positions pos and val at element n.
+    void seek(size_type n, size_type& pos, value_type& val) const {
+        size_type b = n / block_size;
+        pos = offsets_[b];
+        val = firsts_[b];
+        for (size_type i = n % block_size; i > 0; --i) {
+            val = next(pos, val);
+        }
+    }
+
+    // Moves pos and val from element n - 1 to element n.
+    void step(size_type n, size_type& pos, value_type& val) const {
+        if (n % block_size == 0) {
+            pos = offsets_[n / block_size];
+            val = firsts_[n / block_size];
+        } else {
+            val = next(pos, val);
+        }
+    }
+};
+
+template <class T>
+inline void swap(delta_vector<T>& x, delta_vector<T>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
@@ -0,0 +1,466 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#if __cplusplus >= 201103L
+    #include <new>
+#endif
+
+#include "util/enable_if.hpp"
+#include "util/equal.hpp"
+#include "util/index_iterator.hpp"
+#include "util/is_integral.hpp"
+#include "util/iterator_traits.hpp"
+#include "util/lexicographical_compare.hpp"
+#include "util/reverse_iterator.hpp"
+
+namespace ft {
+
+// Double-ended queue stored in fixed-size blocks reached through a map of
+// block pointers. Pushing at either end constructs into the first or last
+// block, adding a block when that one is full; only the map of pointers is
+// ever reallocated, so elements never move and pointers and references to
+// them stay valid across push and pop at both ends. Blocks emptied by pops
+// are kept for later pushes until shrink_to_fit().
+//
+// Iterators are indices from the front, so a push_front or pop_front
+// shifts what they refer to.
+template <class T, class Allocator = std::allocator<T> >
+class deque {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef index_iterator<deque, value_type> iterator;
+    typedef index_iterator<const deque, const value_type> const_iterator;
+    typedef ft::reverse_iterator<iterator> reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    // At least 4 KiB per block, rounded up to whole elements, and at least
+    // 16 elements for large types.
+    static const size_type block_size = sizeof(T) < 256 ? (4096 + sizeof(T) - 1) / sizeof(T) : 16;
+
+private:
+    typedef typename allocator_type::template rebind<pointer>::other map_allocator;
+
+    allocator_type alloc_;
+    pointer* map_;
+    size_type map_size_;
+    // Position of the front element, counted from the start of map_[0].
+    size_type start_;
+    size_type size_;
+
+public:
+    explicit deque(const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , map_(NULL)
+        , map_size_(0)
+        , start_(0)
+        , size_(0)
+    {}
+
+    explicit deque(size_type n, const value_type& val = value_type(),
+                   const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , map_(NULL)
+        , map_size_(0)
+        , start_(0)
+        , size_(0)
+    {
+        try {
+            insert(end(), n, val);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    template <class InputIterator>
+    deque(InputIterator first, InputIterator last,
+          const allocator_type& alloc = allocator_type(),
+          typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : alloc_(alloc)
+        , map_(NULL)
+        , map_size_(0)
+        , start_(0)
+        , size_(0)
+    {
+        try {
+            insert(end(), first, last);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    deque(const deque& x)
+        : alloc_(x.alloc_)
+        , map_(NULL)
+        , map_size_(0)
+        , start_(0)
+        , size_(0)
+    {
+        try {
+            insert(end(), x.begin(), x.end());
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    deque& operator=(const deque& x) {
+        if (this != &x) {
+            deque tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~deque() {
+        vdeallocate();
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, size_); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return size_; }
+    size_type max_size() const { return alloc_.max_size(); }
+    bool empty() const { return size_ == 0; }
+
+    reference operator[](size_type n) { return *locate(n); }
+    const_reference operator[](size_type n) const { return *locate(n); }
+
+    reference at(size_type n) {
+        if (n >= size_) {
+            throw std::out_of_range("deque");
+        }
+        return *locate(n);
+    }
+
+    const_reference at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range("deque");
+        }
+        return *locate(n);
+    }
+
+    reference front() { return *locate(0); }
+    const_reference front() const { return *locate(0); }
+    reference back() { return *locate(size_ - 1); }
+    const_reference back() const { return *locate(size_ - 1); }
+
+    void resize(size_type n, const value_type& val = value_type()) {
+        if (n < size_) {
+            erase(begin() + n, end());
+        } else {
+            insert(end(), n - size_, val);
+        }
+    }
+
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    assign(InputIterator first, InputIterator last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(size_type n, const value_type& val) {
+        value_type tmp(val);
+        clear();
+        insert(end(), n, tmp);
+    }
+
+    void push_back(const value_type& val) {
+        alloc_.construct(back_slot(), val);
+        ++size_;
+    }
+
+    void push_front(const value_type& val) {
+        alloc_.construct(front_slot(), val);
+        --start_;
+        ++size_;
+    }
+
+#if __cplusplus >= 201103L
+    void push_back(value_type&& val) {
+        emplace_back(std::move(val));
+    }
+
+    void push_front(value_type&& val) {
+        emplace_front(std::move(val));
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        ::new (static_cast<void*>(back_slot())) value_type(std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    template <class... Args>
+    void emplace_front(Args&&... args) {
+        ::new (static_cast<void*>(front_slot())) value_type(std::forward<Args>(args)...);
+        --start_;
+        ++size_;
+    }
+#endif
+
+    void pop_back() {
+        alloc_.destroy(locate(size_ - 1));
+        --size_;
+    }
+
+    void pop_front() {
+        alloc_.destroy(locate(0));
+        ++start_;
+        --size_;
+    }
+
+    iterator insert(iterator position, const value_type& val) {
+        size_type d = static_cast<size_type>(position - begin());
+        insert_n(d, 1, val);
+        return begin() + d;
+    }
+
+    void insert(iterator position, size_type n, const value_type& val) {
+        insert_n(static_cast<size_type>(position - begin()), n, val);
+    }
+
+    // Appends the range and rotates it into place, so inserting at end() is
+    // a plain sequence of push_backs.
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    insert(iterator position, InputIterator first, InputIterator last) {
+        size_type d = static_cast<size_type>(position - begin());
+        size_type sz = size_;
+        try {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        } catch (...) {
+            while (size_ != sz) {
+                pop_back();
+            }
+            throw;
+        }
+        std::rotate(begin() + d, begin() + sz, end());
+    }
+
+    iterator erase(iterator position) {
+        return erase(position, position + 1);
+    }
+
+    // Shifts whichever side of [first, last) is shorter over it.
+    iterator erase(iterator first, iterator last) {
+        size_type d = static_cast<size_type>(first - begin());
+        size_type n = static_cast<size_type>(last - first);
+        if (d < size_ - d - n) {
+            std::copy_backward(begin(), first, last);
+            for (; n > 0; --n) {
+                pop_front();
+            }
+        } else {
+            std::copy(last, end(), first);
+            for (; n > 0; --n) {
+                pop_back();
+            }
+        }
+        return begin() + d;
+    }
+
+    void swap(deque& x) {
+        using std::swap;
+        swap(alloc_, x.alloc_);
+        std::swap(map_, x.map_);
+        std::swap(map_size_, x.map_size_);
+        std::swap(start_, x.start_);
+        std::swap(size_, x.size_);
+    }
+
+    // Keeps the blocks; the front restarts at the middle of the map so that
+    // both ends have room.
+    void clear() {
+        while (size_ != 0) {
+            pop_back();
+        }
+        start_ = map_size_ / 2 * block_size;
+    }
+
+    // Frees the blocks that hold no elements.
+    void shrink_to_fit() {
+        size_type first = start_ / block_size;
+        size_type last = first + used_blocks();
+        for (size_type k = 0; k < map_size_; ++k) {
+            if ((k < first || k >= last) && map_[k] != NULL) {
+                alloc_.deallocate(map_[k], block_size);
+                map_[k] = NULL;
+            }
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    pointer locate(size_type n) const {
+        size_type i = start_ + n;
+        return map_[i / block_size] + i % block_size;
+    }
+
+    size_type used_blocks() const {
+        return size_ == 0 ? 0 : (start_ + size_ - 1) / block_size - start_ / block_size + 1;
+    }
+
+    // Returns the slot at position i, allocating its block if it has none.
+    pointer slot(size_type i) {
+        pointer& b = map_[i / block_size];
+        if (b == NULL) {
+            b = alloc_.allocate(block_size);
+        }
+        return b + i % block_size;
+    }
+
+    pointer back_slot() {
+        if (start_ + size_ == map_size_ * block_size) {
+            grow_map();
+        }
+        return slot(start_ + size_);
+    }
+
+    pointer front_slot() {
+        if (start_ == 0) {
+            grow_map();
+        }
+        return slot(start_ - 1);
+    }
+
+    // Leaves a free map entry at both ends of the used blocks: in place if
+    // the map is at most about half used, else in a map twice the size.
+    // Spare blocks move along with their entries, so they get reused.
+    void grow_map() {
+        size_type first = start_ / block_size;
+        size_type used = used_blocks();
+        if (map_size_ >= 2 * used + 2) {
+            size_type new_first = (map_size_ - used) / 2;
+            if (new_first < first) {
+                std::rotate(map_ + new_first, map_ + first, map_ + first + used);
+            } else {
+                std::rotate(map_ + first, map_ + first + used, map_ + new_first + used);
+            }
+            start_ = start_ - first * block_size + new_first * block_size;
+            return;
+        }
+        size_type n = map_size_ == 0 ? 8 : 2 * map_size_;
+        pointer* m = map_allocator(alloc_).allocate(n);
+        std::fill(m, m + n, pointer());
+        size_type new_first = (n - used) / 2;
+        std::copy(map_ + first, map_ + first + used, m + new_first);
+        pointer* spare = m + new_first + used;
+        for (size_type k = 0; k < map_size_; ++k) {
+            if ((k < first || k >= first + used) && map_[k] != NULL) {
+                *spare++ = map_[k];
+            }
+        }
+        if (map_ != NULL) {
+            map_allocator(alloc_).deallocate(map_, map_size_);
+        }
+        map_ = m;
+        map_size_ = n;
+        start_ = start_ - first * block_size + new_first * block_size;
+    }
+
+    // Pushes n copies at the nearer end and rotates them into place at d.
+    void insert_n(size_type d, size_type n, const value_type& val) {
+        size_type sz = size_;
+        if (d < sz - d) {
+            try {
+                for (size_type i = 0; i < n; ++i) {
+                    push_front(val);
+                }
+            } catch (...) {
+                while (size_ != sz) {
+                    pop_front();
+                }
+                throw;
+            }
+            std::rotate(begin(), begin() + n, begin() + n + d);
+        } else {
+            try {
+                for (size_type i = 0; i < n; ++i) {
+                    push_back(val);
+                }
+            } catch (...) {
+                while (size_ != sz) {
+                    pop_back();
+                }
+                throw;
+            }
+            std::rotate(begin() + d, begin() + sz, end());
+        }
+    }
+
+    void vdeallocate() {
+        if (map_ != NULL) {
+            clear();
+            shrink_to_fit();
+            map_allocator(alloc_).deallocate(map_, map_size_);
+            map_ = NULL;
+            map_size_ = 0;
+            start_ = 0;
+        }
+    }
+};
+
+template <class T, class Allocator>
+inline bool operator==(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator>
+inline bool operator!=(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return !(x == y);
+}
+
+template <class T, class Allocator>
+inline bool operator<(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, class Allocator>
+inline bool operator>(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return y < x;
+}
+
+template <class T, class Allocator>
+inline bool operator<=(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return !(y < x);
+}
+
+template <class T, class Allocator>
+inline bool operator>=(const deque<T, Allocator>& x, const deque<T, Allocator>& y) {
+    return !(x < y);
+}
+
+template <class T, class Allocator>
+inline void swap(deque<T, Allocator>& x, deque<T, Allocator>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
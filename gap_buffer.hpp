@@ -0,0 +1,472 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "util/enable_if.hpp"
+#include "util/equal.hpp"
+#include "util/growth_policy.hpp"
+#include "util/index_iterator.hpp"
+#include "util/integral_constant.hpp"
+#include "util/is_integral.hpp"
+#include "util/is_trivially_relocatable.hpp"
+#include "util/iterator_traits.hpp"
+#include "util/lexicographical_compare.hpp"
+#include "util/reverse_iterator.hpp"
+#include "util/uninitialized_transfer.hpp"
+
+namespace ft {
+
+// Sequence stored as one buffer with a movable gap of free slots: elements
+// [0, gap) sit at the front, the rest at the back. Inserting or erasing moves
+// the gap to that position first, so edits near the previous one only move
+// the elements in between, and a run of inserts at a cursor is O(1) each.
+// Iterators are indices and skip the gap.
+template <class T, class Allocator = std::allocator<T> >
+class gap_buffer {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef index_iterator<gap_buffer, value_type> iterator;
+    typedef index_iterator<const gap_buffer, const value_type> const_iterator;
+    typedef ft::reverse_iterator<iterator> reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    allocator_type alloc_;
+    pointer begin_;
+    pointer gap_begin_;
+    pointer gap_end_;
+    pointer end_cap_;
+
+public:
+    explicit gap_buffer(const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , begin_(NULL)
+        , gap_begin_(NULL)
+        , gap_end_(NULL)
+        , end_cap_(NULL)
+    {}
+
+    explicit gap_buffer(size_type n, const value_type& val = value_type(),
+                        const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , begin_(NULL)
+        , gap_begin_(NULL)
+        , gap_end_(NULL)
+        , end_cap_(NULL)
+    {
+        try {
+            insert(end(), n, val);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    template <class InputIterator>
+    gap_buffer(InputIterator first, InputIterator last,
+               const allocator_type& alloc = allocator_type(),
+               typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : alloc_(alloc)
+        , begin_(NULL)
+        , gap_begin_(NULL)
+        , gap_end_(NULL)
+        , end_cap_(NULL)
+    {
+        try {
+            insert(end(), first, last);
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    gap_buffer(const gap_buffer& x)
+        : alloc_(x.alloc_)
+        , begin_(NULL)
+        , gap_begin_(NULL)
+        , gap_end_(NULL)
+        , end_cap_(NULL)
+    {
+        try {
+            insert(end(), x.begin(), x.end());
+        } catch (...) {
+            vdeallocate();
+            throw;
+        }
+    }
+
+    gap_buffer& operator=(const gap_buffer& x) {
+        if (this != &x) {
+            gap_buffer tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~gap_buffer() {
+        vdeallocate();
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return static_cast<size_type>((gap_begin_ - begin_) + (end_cap_ - gap_end_)); }
+    size_type capacity() const { return static_cast<size_type>(end_cap_ - begin_); }
+    size_type max_size() const { return alloc_.max_size(); }
+    bool empty() const { return size() == 0; }
+
+    // Index of the gap, i.e. of the element an insert there would become.
+    size_type gap_position() const { return static_cast<size_type>(gap_begin_ - begin_); }
+
+    reference operator[](size_type n) { return *locate(n); }
+    const_reference operator[](size_type n) const { return *locate(n); }
+
+    reference at(size_type n) {
+        if (n >= size()) {
+            throw std::out_of_range("gap_buffer");
+        }
+        return *locate(n);
+    }
+
+    const_reference at(size_type n) const {
+        if (n >= size()) {
+            throw std::out_of_range("gap_buffer");
+        }
+        return *locate(n);
+    }
+
+    reference front() { return *locate(0); }
+    const_reference front() const { return *locate(0); }
+    reference back() { return *locate(size() - 1); }
+    const_reference back() const { return *locate(size() - 1); }
+
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            if (n > max_size()) {
+                throw std::length_error("gap_buffer");
+            }
+            reallocate(n);
+        }
+    }
+
+    void resize(size_type n, const value_type& val = value_type()) {
+        size_type sz = size();
+        if (n < sz) {
+            erase(begin() + n, end());
+        } else {
+            insert(end(), n - sz, val);
+        }
+    }
+
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    assign(InputIterator first, InputIterator last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(size_type n, const value_type& val) {
+        value_type tmp(val);
+        clear();
+        insert(end(), n, tmp);
+    }
+
+    void push_back(const value_type& val) {
+        insert(end(), val);
+    }
+
+#if __cplusplus >= 201103L
+    void push_back(value_type&& val) {
+        emplace(end(), std::move(val));
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        emplace(end(), std::forward<Args>(args)...);
+    }
+#endif
+
+    void pop_back() {
+        erase(end() - 1);
+    }
+
+    iterator insert(iterator position, const value_type& val) {
+        size_type d = static_cast<size_type>(position - begin());
+        if (&val >= begin_ && &val < end_cap_) {
+            value_type tmp(val);
+            insert_n(d, 1, tmp);
+        } else {
+            insert_n(d, 1, val);
+        }
+        return begin() + d;
+    }
+
+#if __cplusplus >= 201103L
+    iterator insert(iterator position, value_type&& val) {
+        return emplace(position, std::move(val));
+    }
+
+    // The element is built before the gap moves, so args may refer into the
+    // buffer.
+    template <class... Args>
+    iterator emplace(iterator position, Args&&... args) {
+        size_type d = static_cast<size_type>(position - begin());
+        value_type tmp(std::forward<Args>(args)...);
+        if (gap_begin_ == gap_end_) {
+            reallocate(recommend(size() + 1));
+        }
+        move_gap(d);
+        ::new (static_cast<void*>(gap_begin_)) value_type(std::move(tmp));
+        ++gap_begin_;
+        return begin() + d;
+    }
+#endif
+
+    void insert(iterator position, size_type n, const value_type& val) {
+        size_type d = static_cast<size_type>(position - begin());
+        if (&val >= begin_ && &val < end_cap_) {
+            value_type tmp(val);
+            insert_n(d, n, tmp);
+        } else {
+            insert_n(d, n, val);
+        }
+    }
+
+    template <class InputIterator>
+    typename enable_if<!is_integral<InputIterator>::value, void>::type
+    insert(iterator position, InputIterator first, InputIterator last) {
+        insert_range(static_cast<size_type>(position - begin()), first, last,
+                     typename iterator_traits<InputIterator>::iterator_category());
+    }
+
+    iterator erase(iterator position) {
+        return erase(position, position + 1);
+    }
+
+    // Moves the gap to last, then widens it down over [first, last).
+    iterator erase(iterator first, iterator last) {
+        size_type d = static_cast<size_type>(first - begin());
+        if (first != last) {
+            move_gap(static_cast<size_type>(last - begin()));
+            for (pointer p = begin_ + d; gap_begin_ != p; ) {
+                alloc_.destroy(--gap_begin_);
+            }
+        }
+        return begin() + d;
+    }
+
+    void swap(gap_buffer& x) {
+        using std::swap;
+        swap(alloc_, x.alloc_);
+        std::swap(begin_, x.begin_);
+        std::swap(gap_begin_, x.gap_begin_);
+        std::swap(gap_end_, x.gap_end_);
+        std::swap(end_cap_, x.end_cap_);
+    }
+
+    void clear() {
+        while (gap_begin_ != begin_) {
+            alloc_.destroy(--gap_begin_);
+        }
+        while (gap_end_ != end_cap_) {
+            alloc_.destroy(gap_end_++);
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    pointer locate(size_type n) const {
+        pointer p = begin_ + n;
+        return p < gap_begin_ ? p : p + (gap_end_ - gap_begin_);
+    }
+
+    size_type recommend(size_type n) const {
+        size_type ms = max_size();
+        if (n > ms) {
+            throw std::length_error("gap_buffer");
+        }
+        return vector_growth<value_type, allocator_type>::template recommend<value_type>(capacity(), n, ms);
+    }
+
+    void insert_n(size_type d, size_type n, const value_type& val) {
+        if (n == 0) {
+            return;
+        }
+        if (n > static_cast<size_type>(gap_end_ - gap_begin_)) {
+            reallocate(recommend(size() + n));
+        }
+        move_gap(d);
+        for (; n > 0; --n) {
+            alloc_.construct(gap_begin_, val);
+            ++gap_begin_;
+        }
+    }
+
+    // Inserting at a moving cursor keeps the gap there, so each element is O(1).
+    template <class InputIterator>
+    void insert_range(size_type d, InputIterator first, InputIterator last, std::input_iterator_tag) {
+        for (; first != last; ++first, ++d) {
+            insert_n(d, 1, *first);
+        }
+    }
+
+    template <class ForwardIterator>
+    void insert_range(size_type d, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n > static_cast<size_type>(gap_end_ - gap_begin_)) {
+            reallocate(recommend(size() + n));
+        }
+        move_gap(d);
+        for (; first != last; ++first) {
+            alloc_.construct(gap_begin_, *first);
+            ++gap_begin_;
+        }
+    }
+
+    // Moves the gap to index d. Each element crosses the gap on its own, so
+    // the buffer stays valid if a copy throws.
+    void move_gap(size_type d) {
+        pointer p = begin_ + d;
+        if (gap_begin_ == gap_end_) {
+            gap_begin_ = gap_end_ = p;
+        } else if (p < gap_begin_) {
+            move_gap_left(p, is_trivially_relocatable<value_type>());
+        } else if (p > gap_begin_) {
+            move_gap_right(p + (gap_end_ - gap_begin_), is_trivially_relocatable<value_type>());
+        }
+    }
+
+    void move_gap_left(pointer p, true_type) {
+        size_type n = static_cast<size_type>(gap_begin_ - p);
+        std::memmove(static_cast<void*>(gap_end_ - n), static_cast<const void*>(p), n * sizeof(value_type));
+        gap_begin_ -= n;
+        gap_end_ -= n;
+    }
+
+    void move_gap_left(pointer p, false_type) {
+        while (gap_begin_ != p) {
+            uninitialized_transfer(gap_begin_ - 1, gap_begin_, gap_end_ - 1);
+            --gap_end_;
+            alloc_.destroy(--gap_begin_);
+        }
+    }
+
+    void move_gap_right(pointer q, true_type) {
+        size_type n = static_cast<size_type>(q - gap_end_);
+        std::memmove(static_cast<void*>(gap_begin_), static_cast<const void*>(gap_end_), n * sizeof(value_type));
+        gap_begin_ += n;
+        gap_end_ += n;
+    }
+
+    void move_gap_right(pointer q, false_type) {
+        while (gap_end_ != q) {
+            uninitialized_transfer(gap_end_, gap_end_ + 1, gap_begin_);
+            ++gap_begin_;
+            alloc_.destroy(gap_end_++);
+        }
+    }
+
+    // Transfers both halves into a buffer of n slots, keeping the gap in place.
+    void reallocate(size_type n) {
+        pointer p = alloc_.allocate(n);
+        size_type front = static_cast<size_type>(gap_begin_ - begin_);
+        size_type back = static_cast<size_type>(end_cap_ - gap_end_);
+        relocate(p, p + n - back, n, is_trivially_relocatable<value_type>());
+        begin_ = p;
+        gap_begin_ = p + front;
+        gap_end_ = p + n - back;
+        end_cap_ = p + n;
+    }
+
+    void relocate(pointer p, pointer q, size_type, true_type) {
+        if (begin_ != NULL) {
+            std::memcpy(static_cast<void*>(p), static_cast<const void*>(begin_),
+                        (gap_begin_ - begin_) * sizeof(value_type));
+            std::memcpy(static_cast<void*>(q), static_cast<const void*>(gap_end_),
+                        (end_cap_ - gap_end_) * sizeof(value_type));
+            alloc_.deallocate(begin_, capacity());
+        }
+    }
+
+    void relocate(pointer p, pointer q, size_type n, false_type) {
+        pointer front = p;
+        try {
+            front = uninitialized_transfer(begin_, gap_begin_, p);
+            uninitialized_transfer(gap_end_, end_cap_, q);
+        } catch (...) {
+            while (front != p) {
+                alloc_.destroy(--front);
+            }
+            alloc_.deallocate(p, n);
+            throw;
+        }
+        vdeallocate();
+    }
+
+    void vdeallocate() {
+        if (begin_ != NULL) {
+            clear();
+            alloc_.deallocate(begin_, capacity());
+            begin_ = gap_begin_ = gap_end_ = end_cap_ = NULL;
+        }
+    }
+};
+
+template <class T, class Allocator>
+inline bool operator==(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator>
+inline bool operator!=(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return !(x == y);
+}
+
+template <class T, class Allocator>
+inline bool operator<(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, class Allocator>
+inline bool operator>(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return y < x;
+}
+
+template <class T, class Allocator>
+inline bool operator<=(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return !(y < x);
+}
+
+template <class T, class Allocator>
+inline bool operator>=(const gap_buffer<T, Allocator>& x, const gap_buffer<T, Allocator>& y) {
+    return !(x < y);
+}
+
+template <class T, class Allocator>
+inline void swap(gap_buffer<T, Allocator>& x, gap_buffer<T, Allocator>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
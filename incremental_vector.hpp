@@ -0,0 +1,341 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "util/growth_policy.hpp"
+#include "util/index_iterator.hpp"
+#include "util/is_trivially_relocatable.hpp"
+#include "util/reverse_iterator.hpp"
+
+namespace ft {
+
+// A vector that never copies its whole buffer in one operation. When it
+// outgrows its buffer it allocates the new one and leaves the elements where
+// they are; each later push_back then moves a few of them over, enough that
+// migration is done before the new buffer can fill up. Until then element i
+// lives in the old buffer if it has not been migrated yet and in the new one
+// otherwise, and operator[] checks which. Elements are therefore not
+// contiguous while migrating; finish_migration() makes them so.
+template <class T, class Allocator = std::allocator<T> >
+class incremental_vector {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef index_iterator<incremental_vector, value_type> iterator;
+    typedef index_iterator<const incremental_vector, const value_type> const_iterator;
+    typedef ft::reverse_iterator<iterator> reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    allocator_type alloc_;
+    pointer begin_;
+    size_type size_;
+    size_type cap_;
+    // Buffer being migrated from; elements [migrated_, old_size_) still live there.
+    pointer old_;
+    size_type old_cap_;
+    size_type old_size_;
+    size_type migrated_;
+    size_type step_;
+
+public:
+    explicit incremental_vector(const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , begin_(NULL)
+        , size_(0)
+        , cap_(0)
+        , old_(NULL)
+        , old_cap_(0)
+        , old_size_(0)
+        , migrated_(0)
+        , step_(0)
+    {}
+
+    explicit incremental_vector(size_type n, const value_type& val = value_type(),
+                                const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , begin_(NULL)
+        , size_(0)
+        , cap_(0)
+        , old_(NULL)
+        , old_cap_(0)
+        , old_size_(0)
+        , migrated_(0)
+        , step_(0)
+    {
+        try {
+            resize(n, val);
+        } catch (...) {
+            clear();
+            alloc_.deallocate(begin_, cap_);
+            throw;
+        }
+    }
+
+    incremental_vector(const incremental_vector& x)
+        : alloc_(x.alloc_)
+        , begin_(NULL)
+        , size_(0)
+        , cap_(0)
+        , old_(NULL)
+        , old_cap_(0)
+        , old_size_(0)
+        , migrated_(0)
+        , step_(0)
+    {
+        if (x.size_ > 0) {
+            begin_ = alloc_.allocate(x.size_);
+            cap_ = x.size_;
+            try {
+                for (; size_ < x.size_; ++size_) {
+                    alloc_.construct(begin_ + size_, x[size_]);
+                }
+            } catch (...) {
+                clear();
+                alloc_.deallocate(begin_, cap_);
+                throw;
+            }
+        }
+    }
+
+    incremental_vector& operator=(const incremental_vector& x) {
+        if (this != &x) {
+            incremental_vector tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~incremental_vector() {
+        clear();
+        if (begin_ != NULL) {
+            alloc_.deallocate(begin_, cap_);
+        }
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, size_); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return cap_; }
+    bool empty() const { return size_ == 0; }
+    size_type max_size() const { return alloc_.max_size(); }
+
+    // True while some elements still live in the previous buffer.
+    bool migrating() const { return old_ != NULL; }
+
+    reference operator[](size_type n) { return *locate(n); }
+    const_reference operator[](size_type n) const { return *locate(n); }
+
+    reference at(size_type n) {
+        if (n >= size_) {
+            throw std::out_of_range("incremental_vector");
+        }
+        return *locate(n);
+    }
+
+    const_reference at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range("incremental_vector");
+        }
+        return *locate(n);
+    }
+
+    reference front() { return *locate(0); }
+    const_reference front() const { return *locate(0); }
+    reference back() { return *locate(size_ - 1); }
+    const_reference back() const { return *locate(size_ - 1); }
+
+    // Starts migrating to a buffer of at least n elements; like every other
+    // growth, it does not move any element by itself.
+    void reserve(size_type n) {
+        if (n > cap_) {
+            if (n > max_size()) {
+                throw std::length_error("incremental_vector");
+            }
+            grow(n);
+        }
+    }
+
+    // Moves every remaining element to the current buffer in one go.
+    void finish_migration() {
+        migrate(old_size_ - migrated_);
+    }
+
+    // The migration step may move val itself, so an element of the old
+    // buffer is copied out first.
+    void push_back(const value_type& val) {
+        if (old_ != NULL && &val >= old_ && &val < old_ + old_cap_) {
+            value_type tmp(val);
+            append(tmp);
+        } else {
+            append(val);
+        }
+    }
+
+    void pop_back() {
+        truncate(size_ - 1);
+    }
+
+    void resize(size_type n, const value_type& val = value_type()) {
+        if (n < size_) {
+            truncate(n);
+        } else {
+            if (n > cap_) {
+                reserve(n);
+            }
+            while (size_ < n) {
+                push_back(val);
+            }
+        }
+    }
+
+    void clear() {
+        truncate(0);
+    }
+
+    void swap(incremental_vector& x) {
+        using std::swap;
+        swap(alloc_, x.alloc_);
+        std::swap(begin_, x.begin_);
+        std::swap(size_, x.size_);
+        std::swap(cap_, x.cap_);
+        std::swap(old_, x.old_);
+        std::swap(old_cap_, x.old_cap_);
+        std::swap(old_size_, x.old_size_);
+        std::swap(migrated_, x.migrated_);
+        std::swap(step_, x.step_);
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    pointer locate(size_type n) const {
+        if (n >= migrated_ && n < old_size_) {
+            return old_ + n;
+        }
+        return begin_ + n;
+    }
+
+    void append(const value_type& val) {
+        migrate_some();
+        if (size_ == cap_) {
+            grow(recommend(size_ + 1));
+        }
+        alloc_.construct(begin_ + size_, val);
+        ++size_;
+    }
+
+    size_type recommend(size_type n) const {
+        size_type ms = max_size();
+        if (n > ms) {
+            throw std::length_error("incremental_vector");
+        }
+        return vector_growth<value_type, allocator_type>::template recommend<value_type>(cap_, n, ms);
+    }
+
+    // Switches to a new buffer of n elements, leaving the current elements
+    // where they are. A migration still running is finished first; with the
+    // step chosen below that only happens after an explicit reserve.
+    void grow(size_type n) {
+        finish_migration();
+        pointer p = alloc_.allocate(n);
+        if (size_ == 0) {
+            if (begin_ != NULL) {
+                alloc_.deallocate(begin_, cap_);
+            }
+        } else {
+            old_ = begin_;
+            old_cap_ = cap_;
+            old_size_ = size_;
+            migrated_ = 0;
+            // Enough elements per push_back to empty the old buffer before the
+            // new one has no room left.
+            step_ = (size_ + (n - size_) - 1) / (n - size_) + 1;
+        }
+        begin_ = p;
+        cap_ = n;
+    }
+
+    // The share of the migration paid by each push_back. It runs before the
+    // push changes anything, so a throwing copy reaches the caller with the
+    // vector as it was; the elements moved so far simply stay moved.
+    void migrate_some() {
+        if (old_ != NULL) {
+            migrate(step_);
+        }
+    }
+
+    void migrate(size_type n) {
+        if (old_ == NULL) {
+            return;
+        }
+        if (n > old_size_ - migrated_) {
+            n = old_size_ - migrated_;
+        }
+        relocate(begin_ + migrated_, old_ + migrated_, n, is_trivially_relocatable<value_type>());
+        if (migrated_ == old_size_) {
+            alloc_.deallocate(old_, old_cap_);
+            old_ = NULL;
+            old_cap_ = old_size_ = migrated_ = step_ = 0;
+        }
+    }
+
+    void relocate(pointer to, pointer from, size_type n, true_type) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(value_type));
+        migrated_ += n;
+    }
+
+    void relocate(pointer to, pointer from, size_type n, false_type) {
+        for (size_type i = 0; i < n; ++i) {
+#if __cplusplus >= 201103L
+            ::new (static_cast<void*>(to + i)) value_type(std::move_if_noexcept(from[i]));
+#else
+            alloc_.construct(to + i, from[i]);
+#endif
+            alloc_.destroy(from + i);
+            ++migrated_;
+        }
+    }
+
+    // Destroys the elements from index n on, wherever they live.
+    void truncate(size_type n) {
+        while (size_ > n) {
+            --size_;
+            alloc_.destroy(locate(size_));
+        }
+        if (old_size_ > n) {
+            old_size_ = n;
+            if (migrated_ > n) {
+                migrated_ = n;
+            }
+            migrate(0);
+        }
+    }
+};
+
+template <class T, class Allocator>
+void swap(incremental_vector<T, Allocator>& x, incremental_vector<T, Allocator>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
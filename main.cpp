@@ -1,21 +1,38 @@
-#include <deque>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <queue>
 #include <string>
+#include <vector>
 
 #ifdef STD
+    #include <deque>
     #include <map>
     #include <set>
     #include <stack>
     #include <vector>
     namespace ft = std;
 #else
+    #include "concurrent_stack.hpp"
+    #include "delta_vector.hpp"
+    #include "deque.hpp"
+    #include "gap_buffer.hpp"
+    #include "incremental_vector.hpp"
     #include "map.hpp"
+    #include "packed_vector.hpp"
+    #include "persistent_vector.hpp"
+    #include "priority_queue.hpp"
+    #include "ring_queue.hpp"
     #include "set.hpp"
     #include "stack.hpp"
     #include "vector.hpp"
+    #include "util/aligned_allocator.hpp"
+    #include "util/huge_page_allocator.hpp"
 #endif
 
+#include <pthread.h>
 #include <stdlib.h>
+#include <sys/time.h>
 
 #define MAX_RAM 4294967296
 #define BUFFER_SIZE 4096
@@ -45,22 +62,846 @@ public:
     iterator end() { return this->c.end(); }
 };
 
+// Checks of the containers std has no counterpart for. Each runs the same
+// operations on the ft container and on a reference model over ft::vector
+// and compares what they observe. The STD build has no such containers and
+// prints the model's results, so stdout still matches between the builds
+// unless an ft container diverges.
+#ifdef STD
+    #define FT_ONLY(actual, model) (model)
+#else
+    #define FT_ONLY(actual, model) (actual)
+#endif
+
+typedef std::vector<unsigned long> observations;
+
+static void check(const char* name, const observations& got, const observations& expected)
+{
+    size_t i = 0;
+    while (i < got.size() && i < expected.size() && got[i] == expected[i])
+        i++;
+    unsigned long hash = 0;
+    for (size_t j = 0; j < expected.size(); j++)
+        hash = hash * 1000003 + expected[j];
+    std::cout << name << ": " << expected.size() << " values, hash " << hash;
+    if (i == got.size() && i == expected.size())
+        std::cout << ", ok" << std::endl;
+    else
+        std::cout << ", differs at " << i << std::endl;
+}
+
+// One char per bit, for the word-level operations of vector<bool>.
+class bit_model {
+public:
+    size_t size() const { return bits.size(); }
+    void push_back(bool b) { bits.push_back(b); }
+
+    size_t count() const
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < bits.size(); i++)
+            n += bits[i];
+        return n;
+    }
+
+    size_t find_first() const { return find_from(0); }
+    size_t find_next(size_t pos) const { return find_from(pos + 1); }
+
+    void fill(size_t first, size_t last, bool val)
+    {
+        for (; first < last; first++)
+            bits[first] = val;
+    }
+
+    void flip(size_t first, size_t last)
+    {
+        for (; first < last; first++)
+            bits[first] = !bits[first];
+    }
+
+    void flip() { flip(0, bits.size()); }
+
+    bit_model& operator&=(const bit_model& x)
+    {
+        for (size_t i = 0; i < bits.size(); i++)
+            bits[i] &= x.bits[i];
+        return *this;
+    }
+
+    bit_model& operator|=(const bit_model& x)
+    {
+        for (size_t i = 0; i < bits.size(); i++)
+            bits[i] |= x.bits[i];
+        return *this;
+    }
+
+    bit_model& operator^=(const bit_model& x)
+    {
+        for (size_t i = 0; i < bits.size(); i++)
+            bits[i] ^= x.bits[i];
+        return *this;
+    }
+
+private:
+    size_t find_from(size_t pos) const
+    {
+        while (pos < bits.size() && !bits[pos])
+            pos++;
+        return pos;
+    }
+
+    ft::vector<char> bits;
+};
+
+template <class Bits>
+static void record_bits(observations& seen, const Bits& b)
+{
+    seen.push_back(b.size());
+    seen.push_back(b.count());
+    for (size_t i = b.find_first(); i < b.size(); i = b.find_next(i))
+        seen.push_back(i);
+}
+
+// Word logic, fill and flip on sizes around the 64-bit word boundary, where
+// bits past size() in the last word must stay clear for count and find.
+template <class Bits>
+static observations bit_ops(unsigned seed)
+{
+    static const size_t sizes[] = { 1, 63, 64, 65, 127, 130, 200 };
+    observations seen;
+    unsigned x = seed;
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+    {
+        size_t n = sizes[k];
+        Bits a;
+        Bits b;
+        for (size_t i = 0; i < n; i++)
+        {
+            x = x * 1103515245 + 12345;
+            a.push_back((x >> 16) & 1);
+            b.push_back((x >> 17) % 3 == 0);
+        }
+        record_bits(seen, a);
+        a &= b;
+        record_bits(seen, a);
+        a |= b;
+        record_bits(seen, a);
+        a ^= b;
+        record_bits(seen, a);
+        a.fill(n / 3, n, true);
+        record_bits(seen, a);
+        a.flip(n / 2, n);
+        record_bits(seen, a);
+        a.flip();
+        record_bits(seen, a);
+        a.push_back(false);
+        a.push_back(true);
+        record_bits(seen, a);
+    }
+    return seen;
+}
+
+template <class Sequence>
+static void record_values(observations& seen, const Sequence& s)
+{
+    seen.push_back(s.size());
+    for (size_t i = 0; i < s.size(); i++)
+        seen.push_back(static_cast<unsigned long>(s[i]));
+}
+
+// packed_vector's interface over plain storage.
+template <class T>
+class packed_model {
+public:
+    size_t size() const { return v.size(); }
+    T operator[](size_t i) const { return v[i]; }
+    void push_back(T x) { v.push_back(x); }
+    void set(size_t i, T x) { v[i] = x; }
+
+    void decode(size_t first, size_t n, T* out) const
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = v[first + i];
+    }
+
+private:
+    ft::vector<T> v;
+};
+
+template <class Packed, class T>
+static void record_decodes(observations& seen, const Packed& p)
+{
+    T out[64];
+    for (size_t first = 0; first < 70; first++)
+    {
+        p.decode(first, 64, out);
+        for (size_t i = 0; i < 64; i++)
+            seen.push_back(static_cast<unsigned long>(out[i]));
+    }
+}
+
+// A slowly widening range makes packed_vector repack once per bit, then the
+// extremes of T widen it to every bit. decode() runs from each offset within
+// a word at both widths.
+template <class Packed, class T>
+static observations packed_ops(unsigned seed)
+{
+    observations seen;
+    Packed p;
+    unsigned x = seed;
+    for (int i = 0; i < 300; i++)
+    {
+        x = x * 1103515245 + 12345;
+        p.push_back(static_cast<T>((x >> 16) % (i + 1)));
+    }
+    record_values(seen, p);
+    record_decodes<Packed, T>(seen, p);
+    p.set(7, std::numeric_limits<T>::max());
+    p.set(8, std::numeric_limits<T>::min());
+    p.push_back(std::numeric_limits<T>::min());
+    p.push_back(std::numeric_limits<T>::max());
+    record_values(seen, p);
+    record_decodes<Packed, T>(seen, p);
+    return seen;
+}
+
+// Mostly increasing values with the extremes of T mixed in, so some deltas
+// wrap around T, over several blocks; then pop_back across a block boundary.
+template <class Deltas, class T>
+static observations delta_ops(unsigned seed)
+{
+    observations seen;
+    Deltas d;
+    unsigned x = seed;
+    for (int i = 0; i < 1000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        if (i % 97 == 0)
+            d.push_back(std::numeric_limits<T>::min());
+        else if (i % 89 == 0)
+            d.push_back(std::numeric_limits<T>::max());
+        else
+            d.push_back(static_cast<T>(i * 1000 + (x >> 16) % 2000));
+    }
+    record_values(seen, d);
+    for (typename Deltas::const_iterator it = d.begin(); it != d.end(); ++it)
+        seen.push_back(static_cast<unsigned long>(*it));
+    for (int i = 0; i < 300; i++)
+    {
+        d.pop_back();
+        seen.push_back(static_cast<unsigned long>(d.back()));
+    }
+    d.push_back(std::numeric_limits<T>::min());
+    record_values(seen, d);
+    return seen;
+}
+
+// Old versions keep their contents through later updates, a slice grows
+// without touching the vector it came from, and a transient keeps working
+// after persistent() without changing the version it handed out.
+#ifndef STD
+static observations persistent_versions(unsigned seed)
+{
+    typedef ft::persistent_vector<int> pvec;
+    observations seen;
+    ft::vector<pvec> versions;
+    pvec v;
+    unsigned x = seed;
+    for (int i = 0; i < 2000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        if (i % 3 == 0 && !v.empty())
+            v = v.set((x >> 16) % v.size(), i);
+        else
+            v = v.push_back(i);
+        if (i % 250 == 0)
+            versions.push_back(v);
+    }
+    pvec sliced = v.slice(100, 1100).push_back(-1).push_back(-2);
+    pvec::transient t(v);
+    t.set(0, -3);
+    t.push_back(-4);
+    pvec first = t.persistent();
+    t.set(0, -5);
+    t.pop_back();
+    t.push_back(-6);
+    pvec second = t.persistent();
+    for (size_t i = 0; i < versions.size(); i++)
+        record_values(seen, versions[i]);
+    record_values(seen, v);
+    record_values(seen, sliced);
+    record_values(seen, first);
+    record_values(seen, second);
+    return seen;
+}
+#endif
+
+// The same edits on copies of ft::vector.
+static observations persistent_model(unsigned seed)
+{
+    typedef ft::vector<int> pvec;
+    observations seen;
+    ft::vector<pvec> versions;
+    pvec v;
+    unsigned x = seed;
+    for (int i = 0; i < 2000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        if (i % 3 == 0 && !v.empty())
+            v[(x >> 16) % v.size()] = i;
+        else
+            v.push_back(i);
+        if (i % 250 == 0)
+            versions.push_back(v);
+    }
+    pvec sliced(v.begin() + 100, v.begin() + 1100);
+    sliced.push_back(-1);
+    sliced.push_back(-2);
+    pvec t(v);
+    t[0] = -3;
+    t.push_back(-4);
+    pvec first = t;
+    t[0] = -5;
+    t.pop_back();
+    t.push_back(-6);
+    pvec second = t;
+    for (size_t i = 0; i < versions.size(); i++)
+        record_values(seen, versions[i]);
+    record_values(seen, v);
+    record_values(seen, sliced);
+    record_values(seen, first);
+    record_values(seen, second);
+    return seen;
+}
+
+// Inserts and erases at a cursor that mostly moves by one, as in an editor,
+// with an occasional jump and range erase.
+template <class Sequence>
+static observations cursor_edits(unsigned seed)
+{
+    observations seen;
+    Sequence s;
+    size_t cursor = 0;
+    unsigned x = seed;
+    for (int i = 0; i < 20000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        if (r % 32 == 0)
+            cursor = r % (s.size() + 1);
+        else if (r % 8 == 0 && cursor > 0)
+            cursor--;
+        if (r % 64 == 1 && cursor < s.size())
+        {
+            size_t last = cursor + 5 < s.size() ? cursor + 5 : s.size();
+            s.erase(s.begin() + cursor, s.begin() + last);
+        }
+        else if (r % 3 == 0 && cursor < s.size())
+            s.erase(s.begin() + cursor);
+        else
+            s.insert(s.begin() + cursor++, static_cast<int>(r));
+        seen.push_back(s.size());
+        if (cursor < s.size())
+            seen.push_back(s[cursor]);
+    }
+    record_values(seen, s);
+    return seen;
+}
+
+// Pushes with a pop after every third one, then pops the rest; records
+// every top.
+template <class Queue>
+static observations pop_order(unsigned seed)
+{
+    observations seen;
+    Queue q;
+    unsigned x = seed;
+    for (int i = 0; i < 20000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        q.push(static_cast<int>(x >> 16) % 5000);
+        if (i % 3 == 2)
+        {
+            seen.push_back(q.top());
+            q.pop();
+        }
+    }
+    for (; !q.empty(); q.pop())
+        seen.push_back(q.top());
+    return seen;
+}
+
+// Distinct for each step, so that the model's maximum is the queue's top.
+static int unique_priority(int step)
+{
+    return static_cast<int>(static_cast<long>(step) * 7919 % 1000003);
+}
+
+// Random pushes, updates, erases and pops through handles. After each one
+// records the size, the top and the priority of a random live handle, which
+// goes through pos_ and so shows a stale heap index.
+#ifndef STD
+static observations indexed_ops(unsigned seed)
+{
+    typedef ft::indexed_priority_queue<int> queue;
+    observations seen;
+    queue q;
+    ft::vector<queue::handle_type> live;
+    unsigned x = seed;
+    for (int i = 0; i < 5000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        size_t k = live.empty() ? 0 : (r >> 3) % live.size();
+        if (live.empty() || r % 8 < 4)
+            live.push_back(q.push(unique_priority(i)));
+        else if (r % 8 < 6)
+            q.update(live[k], unique_priority(i));
+        else
+        {
+            if (r % 8 == 7)
+            {
+                k = 0;
+                while (live[k] != q.top_handle())
+                    k++;
+            }
+            q.erase(live[k]);
+            live[k] = live.back();
+            live.pop_back();
+        }
+        seen.push_back(q.size());
+        if (!q.empty())
+            seen.push_back(q.top());
+        if (!live.empty())
+            seen.push_back(q.priority(live[(r >> 5) % live.size()]));
+    }
+    for (; !q.empty(); q.pop())
+        seen.push_back(q.top());
+    return seen;
+}
+#endif
+
+// The same operations on a list of priorities, one per live handle.
+static observations indexed_model(unsigned seed)
+{
+    observations seen;
+    ft::vector<int> live;
+    unsigned x = seed;
+    for (int i = 0; i < 5000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        size_t k = live.empty() ? 0 : (r >> 3) % live.size();
+        if (live.empty() || r % 8 < 4)
+            live.push_back(unique_priority(i));
+        else if (r % 8 < 6)
+            live[k] = unique_priority(i);
+        else
+        {
+            if (r % 8 == 7)
+            {
+                k = 0;
+                for (size_t j = 1; j < live.size(); j++)
+                    if (live[j] > live[k])
+                        k = j;
+            }
+            live[k] = live.back();
+            live.pop_back();
+        }
+        seen.push_back(live.size());
+        if (!live.empty())
+        {
+            size_t top = 0;
+            for (size_t j = 1; j < live.size(); j++)
+                if (live[j] > live[top])
+                    top = j;
+            seen.push_back(live[top]);
+            seen.push_back(live[(r >> 5) % live.size()]);
+        }
+    }
+    std::sort(live.begin(), live.end());
+    for (size_t j = live.size(); j > 0; j--)
+        seen.push_back(live[j - 1]);
+    return seen;
+}
+
+static void ft_checks(unsigned seed)
+{
+    check("vector<bool> word ops",
+          FT_ONLY(bit_ops<ft::vector<bool> >(seed), bit_ops<bit_model>(seed)),
+          bit_ops<bit_model>(seed));
+    check("packed_vector<int>",
+          FT_ONLY((packed_ops<ft::packed_vector<int>, int>(seed)), (packed_ops<packed_model<int>, int>(seed))),
+          packed_ops<packed_model<int>, int>(seed));
+    check("packed_vector<long>",
+          FT_ONLY((packed_ops<ft::packed_vector<long>, long>(seed)), (packed_ops<packed_model<long>, long>(seed))),
+          packed_ops<packed_model<long>, long>(seed));
+    check("delta_vector<int>",
+          FT_ONLY((delta_ops<ft::delta_vector<int>, int>(seed)), (delta_ops<ft::vector<int>, int>(seed))),
+          delta_ops<ft::vector<int>, int>(seed));
+    check("delta_vector<long>",
+          FT_ONLY((delta_ops<ft::delta_vector<long>, long>(seed)), (delta_ops<ft::vector<long>, long>(seed))),
+          delta_ops<ft::vector<long>, long>(seed));
+    check("gap_buffer cursor edits",
+          FT_ONLY(cursor_edits<ft::gap_buffer<int> >(seed), cursor_edits<ft::vector<int> >(seed)),
+          cursor_edits<ft::vector<int> >(seed));
+    check("persistent_vector versions",
+          FT_ONLY(persistent_versions(seed), persistent_model(seed)),
+          persistent_model(seed));
+    check("priority_queue pop order", pop_order<ft::priority_queue<int> >(seed),
+          pop_order<std::priority_queue<int> >(seed));
+    check("indexed_priority_queue handles",
+          FT_ONLY(indexed_ops(seed), indexed_model(seed)),
+          indexed_model(seed));
+}
+
+#ifndef STD
+// Benchmarks of the ft-only containers and allocators, run by
+// ./test seed --bench instead of the comparison. They take several seconds
+// and up to 512 MiB of memory. Timings go to stderr.
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void report(const char* name, double t, const char* baseline, double tb)
+{
+    std::cerr << name << ": " << t << "s, " << baseline << ": " << tb << "s" << std::endl;
+}
+
+// Random reads over 512 MiB of ints. With 4 KiB pages almost every read
+// misses the TLB; the 256 huge pages of huge_page_allocator fit in it.
+template <class Vector>
+static double random_reads(unsigned seed)
+{
+    Vector v(128 * 1024 * 1024, 1);
+    unsigned x = seed;
+    unsigned sum = 0;
+    double t = now();
+    for (int i = 0; i < 20000000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        sum += v[x % v.size()];
+    }
+    t = now() - t;
+    if (sum == 0)
+        std::cerr << sum;
+    return t;
+}
+
+// Slowest single push_back while growing to 16M ints: vector copies its
+// whole buffer when it fills up, incremental_vector a few elements per push.
+template <class Vector>
+static double max_push_back_latency()
+{
+    Vector v;
+    double worst = 0;
+    for (int i = 0; i < 16 * 1024 * 1024; i++)
+    {
+        double t = now();
+        v.push_back(i);
+        t = now() - t;
+        if (t > worst)
+            worst = t;
+    }
+    return worst;
+}
+
+// 1M random inserts, 1M erase + insert pairs, then five in-order walks.
+// Over pool_allocator the nodes come from slabs instead of malloc, and the
+// erased nodes' slots are reused by the next inserts.
+template <class Map>
+static double map_churn(unsigned seed)
+{
+    Map m;
+    unsigned x = seed;
+    long sum = 0;
+    double t = now();
+    for (int i = 0; i < 1000000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        m.insert(ft::make_pair(static_cast<int>(x >> 1), i));
+    }
+    for (int i = 0; i < 1000000; i++)
+    {
+        m.erase(m.begin());
+        x = x * 1103515245 + 12345;
+        m.insert(ft::make_pair(static_cast<int>(x >> 1), i));
+    }
+    for (int k = 0; k < 5; k++)
+        for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+            sum += it->second;
+    t = now() - t;
+    if (sum == 0)
+        std::cerr << sum;
+    return t;
+}
+
+// y += a * x over many short vectors, 16 floats (one 64-byte register) at a
+// time. Over aligned_allocator the kernel runs whole aligned registers,
+// reading and writing the padding past size(); over std::allocator it has to
+// load unaligned and finish the last partial register one float at a time.
+typedef float float16 __attribute__((vector_size(64)));
+typedef float unaligned_float16 __attribute__((vector_size(64), aligned(4)));
+
+static void saxpy_padded(float a, const float* x, float* y, size_t n)
+{
+    for (size_t i = 0; i < n; i += 16)
+        *reinterpret_cast<float16*>(y + i) += a * *reinterpret_cast<const float16*>(x + i);
+}
+
+static void saxpy_tail(float a, const float* x, float* y, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        *reinterpret_cast<unaligned_float16*>(y + i) += a * *reinterpret_cast<const unaligned_float16*>(x + i);
+    for (; i < n; i++)
+        y[i] += a * x[i];
+}
+
+template <class Vector, bool Padded>
+static double short_saxpy(unsigned seed)
+{
+    std::vector<Vector> xs(2000);
+    std::vector<Vector> ys(xs.size());
+    unsigned r = seed;
+    for (size_t i = 0; i < xs.size(); i++)
+    {
+        r = r * 1103515245 + 12345;
+        size_t n = 1 + (r >> 16) % 100;
+        for (size_t j = 0; j < n; j++)
+        {
+            xs[i].push_back(static_cast<float>(j));
+            ys[i].push_back(1.0f);
+        }
+        // The padding holds whatever the allocator left there; zero it so
+        // the kernel does not compute on garbage (or denormals).
+        for (size_t j = n; Padded && j % 16 != 0; j++)
+        {
+            (&xs[i][0])[j] = 0;
+            (&ys[i][0])[j] = 0;
+        }
+    }
+    double t = now();
+    for (int pass = 0; pass < 5000; pass++)
+        for (size_t i = 0; i < xs.size(); i++)
+            (Padded ? saxpy_padded : saxpy_tail)(0.5f, &xs[i][0], &ys[i][0], xs[i].size());
+    t = now() - t;
+    if (ys[0][0] == 0)
+        std::cerr << ys[0][0];
+    return t;
+}
+
+// ft::stack behind a mutex, the way it is shared between threads today.
+class mutex_stack {
+public:
+    mutex_stack() { pthread_mutex_init(&m, NULL); }
+    ~mutex_stack() { pthread_mutex_destroy(&m); }
+
+    void push(int v)
+    {
+        pthread_mutex_lock(&m);
+        s.push(v);
+        pthread_mutex_unlock(&m);
+    }
+
+    bool try_pop(int& v)
+    {
+        pthread_mutex_lock(&m);
+        bool ok = !s.empty();
+        if (ok)
+        {
+            v = s.top();
+            s.pop();
+        }
+        pthread_mutex_unlock(&m);
+        return ok;
+    }
+
+private:
+    pthread_mutex_t m;
+    ft::stack<int> s;
+};
+
+template <class Stack>
+static void* push_pop(void* arg)
+{
+    Stack* s = static_cast<Stack*>(arg);
+    int v;
+    for (int i = 0; i < 1000000; i++)
+    {
+        s->push(i);
+        s->try_pop(v);
+    }
+    return NULL;
+}
+
+// Eight threads each pushing and popping a million ints on one shared stack.
+template <class Stack>
+static double stack_contention()
+{
+    Stack s;
+    pthread_t threads[8];
+    double t = now();
+    for (int i = 0; i < 8; i++)
+        pthread_create(&threads[i], NULL, push_pop<Stack>, &s);
+    for (int i = 0; i < 8; i++)
+        pthread_join(threads[i], NULL);
+    return now() - t;
+}
+
+// ft::deque behind a mutex, the way pipeline stages hand records on today.
+// Bounded like the ring queues, with the same batch interface.
+class mutex_queue {
+public:
+    explicit mutex_queue(size_t n) : cap(n) { pthread_mutex_init(&m, NULL); }
+    ~mutex_queue() { pthread_mutex_destroy(&m); }
+
+    const int* try_push(const int* first, const int* last)
+    {
+        pthread_mutex_lock(&m);
+        for (; first != last && q.size() < cap; ++first)
+            q.push_back(*first);
+        pthread_mutex_unlock(&m);
+        return first;
+    }
+
+    size_t try_pop(int* out, size_t n)
+    {
+        pthread_mutex_lock(&m);
+        size_t k = 0;
+        for (; k < n && !q.empty(); ++k)
+        {
+            out[k] = q.front();
+            q.pop_front();
+        }
+        pthread_mutex_unlock(&m);
+        return k;
+    }
+
+private:
+    pthread_mutex_t m;
+    size_t cap;
+    ft::deque<int> q;
+};
+
+template <class Queue>
+struct pipeline {
+    pipeline(size_t each, size_t all) : q(4096), per_producer(each), total(all), popped(0) {}
+
+    Queue q;
+    size_t per_producer;
+    size_t total;
+    size_t popped;
+};
+
+template <class Queue>
+static void* produce(void* arg)
+{
+    pipeline<Queue>* p = static_cast<pipeline<Queue>*>(arg);
+    int batch[64];
+    for (size_t i = 0; i < p->per_producer; i += 64)
+    {
+        for (int j = 0; j < 64; j++)
+            batch[j] = static_cast<int>(i) + j;
+        const int* first = batch;
+        const int* last = batch + 64;
+        for (unsigned spins = 0; first != last; )
+        {
+            const int* next = p->q.try_push(first, last);
+            if (next == first)
+                spin_wait(spins);
+            first = next;
+        }
+    }
+    return NULL;
+}
+
+template <class Queue>
+static void* consume(void* arg)
+{
+    pipeline<Queue>* p = static_cast<pipeline<Queue>*>(arg);
+    int batch[64];
+    unsigned spins = 0;
+    while (atomic_load_relaxed(&p->popped) < p->total)
+    {
+        size_t n = p->q.try_pop(batch, 64);
+        if (n == 0)
+            spin_wait(spins);
+        else
+            atomic_fetch_add(&p->popped, n);
+    }
+    return NULL;
+}
+
+// Threads producers and as many consumers handing 8M ints through one
+// 4096-slot queue in batches of 64.
+template <class Queue>
+static double queue_throughput(int threads)
+{
+    pipeline<Queue> p(8 * 1024 * 1024 / threads, 8 * 1024 * 1024);
+    pthread_t producers[4];
+    pthread_t consumers[4];
+    double t = now();
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_create(&producers[i], NULL, produce<Queue>, &p);
+        pthread_create(&consumers[i], NULL, consume<Queue>, &p);
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+    return now() - t;
+}
+
+static void benchmarks(unsigned seed)
+{
+    report("random reads, huge_page_allocator", random_reads<ft::vector<int, ft::huge_page_allocator<int> > >(seed),
+           "std::allocator", random_reads<ft::vector<int> >(seed));
+    report("short saxpy, aligned_allocator", short_saxpy<ft::vector<float, ft::aligned_allocator<float> >, true>(seed),
+           "std::allocator", short_saxpy<ft::vector<float>, false>(seed));
+    report("map churn, pool_allocator", map_churn<ft::pool_map<int, int>::type>(seed),
+           "std::allocator", map_churn<ft::map<int, int> >(seed));
+    report("8-thread push/pop, concurrent_stack", stack_contention<ft::concurrent_stack<int> >(),
+           "mutex + stack", stack_contention<mutex_stack>());
+    report("1:1 queue throughput, spsc_queue", queue_throughput<ft::spsc_queue<int> >(1),
+           "mutex + deque", queue_throughput<mutex_queue>(1));
+    report("4:4 queue throughput, mpmc_queue", queue_throughput<ft::mpmc_queue<int> >(4),
+           "mutex + deque", queue_throughput<mutex_queue>(4));
+    report("max push_back latency, incremental_vector", max_push_back_latency<ft::incremental_vector<int> >(),
+           "vector", max_push_back_latency<ft::vector<int> >());
+}
+#endif
+
 int main(int argc, char** argv) {
-    if (argc != 2)
+    const bool bench = argc == 3 && std::string(argv[2]) == "--bench";
+    if (argc != 2 && !bench)
     {
-        std::cerr << "Usage: ./test seed" << std::endl;
+        std::cerr << "Usage: ./test seed [--bench]" << std::endl;
         std::cerr << "Provide a seed please" << std::endl;
         std::cerr << "Count value:" << COUNT << std::endl;
         return 1;
     }
     const int seed = atoi(argv[1]);
     srand(seed);
+#ifndef STD
+    if (bench)
+    {
+        benchmarks(seed);
+        return (0);
+    }
+#endif
 
     ft::vector<std::string> vector_str;
     ft::vector<int> vector_int;
     ft::stack<int> stack_int;
     ft::vector<Buffer> vector_buffer;
-    ft::stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+    ft::stack<Buffer, ft::deque<Buffer> > stack_deq_buffer;
     ft::map<int, int> map_int;
 
     for (int i = 0; i < COUNT; i++)
@@ -113,5 +954,6 @@ int main(int argc, char** argv) {
         std::cout << *it;
     }
     std::cout << std::endl;
+    ft_checks(seed);
     return (0);
 }
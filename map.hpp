@@ -5,9 +5,14 @@
 #include <memory>
 #include <utility>
 
+#if __cplusplus >= 201103L
+    #include <type_traits>
+#endif
+
 #include "util/equal.hpp"
 #include "util/lexicographical_compare.hpp"
 #include "util/pair.hpp"
+#include "util/pool_allocator.hpp"
 #include "util/reverse_iterator.hpp"
 #include "util/tree.hpp"
 #include "util/unique_ptr.hpp"
@@ -296,6 +301,16 @@ public:
         return *this;
     }
 
+#if __cplusplus >= 201103L
+    map(map&& m) noexcept(std::is_nothrow_move_constructible<tree_type>::value)
+        : tree_(std::move(m.tree_)) {}
+
+    map& operator=(map&& m) noexcept(std::is_nothrow_move_assignable<tree_type>::value) {
+        tree_ = std::move(m.tree_);
+        return *this;
+    }
+#endif
+
     allocator_type get_allocator() const { return allocator_type(tree_.get_allocator()); }
 
     iterator begin() { return tree_.begin(); }
@@ -332,6 +347,26 @@ public:
         return tree_.insert_unique(hint.iter, v);
     }
 
+#if __cplusplus >= 201103L
+    pair<iterator, bool> insert(value_type&& v) {
+        return tree_.__insert_unique(std::move(v));
+    }
+
+    iterator insert(iterator hint, value_type&& v) {
+        return tree_.__insert_unique(hint.iter, std::move(v));
+    }
+
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.__emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(iterator hint, Args&&... args) {
+        return tree_.__emplace_hint_unique(hint.iter, std::forward<Args>(args)...);
+    }
+#endif
+
     template <class InputIterator>
     void insert(InputIterator first, InputIterator last) {
         for (iterator e = end(); first != last; ++first) {
@@ -404,7 +439,7 @@ template <class Key, class T, class Compare, class Allocator>
 bool operator==(const map<Key, T, Compare, Allocator>& x,
                 const map<Key, T, Compare, Allocator>& y)
 {
-    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 }
 
 template <class Key, class T, class Compare, class Allocator>
@@ -418,7 +453,7 @@ template <class Key, class T, class Compare, class Allocator>
 bool operator<(const map<Key, T, Compare, Allocator>& x,
                const map<Key, T, Compare, Allocator>& y)
 {
-    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
 template <class Key, class T, class Compare, class Allocator>
@@ -449,4 +484,11 @@ void swap(const map<Key, T, Compare, Allocator>& x,
     x.swap(y);
 }
 
+// A map whose nodes come from pool_allocator:
+//     ft::pool_map<int, std::string>::type m;
+template <class Key, class T, class Compare = std::less<Key> >
+struct pool_map {
+    typedef map<Key, T, Compare, pool_allocator<pair<const Key, T> > > type;
+};
+
 } // namespace ft
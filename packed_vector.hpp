@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+#include "util/enable_if.hpp"
+#include "util/integral_constant.hpp"
+#include "util/is_integral.hpp"
+#include "util/iterator_traits.hpp"
+#include "util/unpack_bits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+template <class T>
+class packed_vector;
+
+// Random-access iterator that keeps its word and bit offset, so stepping to
+// the next element is an add and a shift instead of locating it from its
+// index. Like a vector iterator, any modification of the vector invalidates
+// it.
+template <class T>
+class packed_vector_iterator {
+private:
+    typedef typename packed_vector<T>::word_type word_type;
+
+    const packed_vector<T>* c;
+    std::size_t i;
+    const word_type* w;
+    unsigned off;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef T reference;
+
+    packed_vector_iterator() : c(NULL), i(0), w(NULL), off(0) {}
+
+    packed_vector_iterator(const packed_vector<T>* c, std::size_t i) : c(c), i(i) {
+        seek();
+    }
+
+    reference operator*() const { return c->value_at(c->extract(w, off)); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    packed_vector_iterator& operator++() {
+        ++i;
+        off += c->width_;
+        w += off / packed_vector<T>::bits_per_word;
+        off %= packed_vector<T>::bits_per_word;
+        return *this;
+    }
+
+    packed_vector_iterator operator++(int) {
+        packed_vector_iterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    packed_vector_iterator& operator--() {
+        --i;
+        seek();
+        return *this;
+    }
+
+    packed_vector_iterator operator--(int) {
+        packed_vector_iterator tmp(*this);
+        --*this;
+        return tmp;
+    }
+
+    packed_vector_iterator& operator+=(difference_type n) {
+        i += n;
+        seek();
+        return *this;
+    }
+
+    packed_vector_iterator& operator-=(difference_type n) {
+        return *this += -n;
+    }
+
+    packed_vector_iterator operator+(difference_type n) const {
+        packed_vector_iterator tmp(*this);
+        return tmp += n;
+    }
+
+    packed_vector_iterator operator-(difference_type n) const {
+        packed_vector_iterator tmp(*this);
+        return tmp -= n;
+    }
+
+    friend packed_vector_iterator operator+(difference_type n, const packed_vector_iterator& x) { return x + n; }
+
+    friend difference_type operator-(const packed_vector_iterator& x, const packed_vector_iterator& y) {
+        return static_cast<difference_type>(x.i - y.i);
+    }
+
+    friend bool operator==(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i == y.i; }
+    friend bool operator!=(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i != y.i; }
+    friend bool operator<(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i < y.i; }
+    friend bool operator>(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i > y.i; }
+    friend bool operator<=(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i <= y.i; }
+    friend bool operator>=(const packed_vector_iterator& x, const packed_vector_iterator& y) { return x.i >= y.i; }
+
+private:
+    void seek() {
+        std::size_t bit = i * c->width_;
+        w = &c->words_[0] + bit / packed_vector<T>::bits_per_word;
+        off = static_cast<unsigned>(bit % packed_vector<T>::bits_per_word);
+    }
+};
+
+// Integer sequence stored as value - base in bit_width() bits each, packed
+// into 64-bit words (fixed-width frame-of-reference encoding). Reads are
+// O(1). A value that does not fit makes the vector repack every element with
+// a lower base and at least one more bit, so a vector repacks at most once
+// per bit of width.
+template <class T>
+class packed_vector {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type const_reference;
+    typedef packed_vector_iterator<T> const_iterator;
+    typedef const_iterator iterator;
+
+private:
+    typedef char integral_only[is_integral<T>::value ? 1 : -1];
+    typedef unsigned long word_type;
+
+    static const unsigned bits_per_word = sizeof(word_type) * 8;
+    static const unsigned value_bits = sizeof(value_type) * 8;
+
+    // Always one word longer than the packed bits need, so a value that
+    // straddles two words can be read and written without a bounds check.
+    vector<word_type> words_;
+    size_type size_;
+    unsigned width_;
+    value_type base_;
+
+public:
+    packed_vector() : words_(1, 0), size_(0), width_(0), base_(0) {}
+
+    template <class InputIterator>
+    packed_vector(InputIterator first, InputIterator last,
+                  typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : words_(1, 0)
+        , size_(0)
+        , width_(0)
+        , base_(0)
+    {
+        init_range(first, last, typename iterator_traits<InputIterator>::iterator_category());
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Bits per element and the value they are relative to.
+    unsigned bit_width() const { return width_; }
+    value_type base() const { return base_; }
+
+    value_type operator[](size_type n) const { return value_at(get(n)); }
+
+    value_type at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range("packed_vector");
+        }
+        return (*this)[n];
+    }
+
+    value_type front() const { return (*this)[0]; }
+    value_type back() const { return (*this)[size_ - 1]; }
+
+    void reserve(size_type n) {
+        words_.reserve(words(n, width_));
+    }
+
+    void push_back(value_type val) {
+        make_fit(val, val);
+        words_.resize(words(size_ + 1, width_), 0);
+        put(size_, offset(val));
+        ++size_;
+    }
+
+    void pop_back() {
+        put(--size_, 0);
+        words_.resize(words(size_, width_));
+    }
+
+    void set(size_type n, value_type val) {
+        make_fit(val, val);
+        put(n, offset(val));
+    }
+
+    void clear() {
+        words_.assign(1, 0);
+        size_ = 0;
+        width_ = 0;
+        base_ = 0;
+    }
+
+    void swap(packed_vector& x) {
+        words_.swap(x.words_);
+        std::swap(size_, x.size_);
+        std::swap(width_, x.width_);
+        std::swap(base_, x.base_);
+    }
+
+    // Writes elements [first, first + n) to out, eight at a time with AVX2
+    // for 32-bit elements of up to 25 bits, and otherwise streaming through
+    // the words instead of locating each element on its own.
+    void decode(size_type first, size_type n, value_type* out) const {
+        size_type i = decode_simd(first, n, out, integral_constant<bool, sizeof(value_type) == 4>());
+        size_type bit = (first + i) * width_;
+        const word_type* w = &words_[bit / bits_per_word];
+        unsigned off = bit % bits_per_word;
+        for (; i < n; ++i) {
+            out[i] = value_at(extract(w, off));
+            off += width_;
+            w += off / bits_per_word;
+            off %= bits_per_word;
+        }
+    }
+
+private:
+    friend class packed_vector_iterator<T>;
+
+    // The words are read as bytes, which matches the bit order only on
+    // little-endian targets; the spare last word keeps the four-byte reads
+    // in bounds.
+    size_type decode_simd(size_type first, size_type n, value_type* out, true_type) const {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return unpack_bits32(reinterpret_cast<const unsigned char*>(&words_[0]), first * width_, width_, n,
+                             static_cast<unsigned>(base_), reinterpret_cast<unsigned*>(out));
+#else
+        return 0;
+#endif
+    }
+
+    size_type decode_simd(size_type, size_type, value_type*, false_type) const {
+        return 0;
+    }
+
+    // Adds in word_type, since base_ plus an offset may overflow value_type
+    // on the way to a result that fits.
+    value_type value_at(word_type v) const {
+        return static_cast<value_type>(static_cast<word_type>(base_) + v);
+    }
+
+    word_type extract(const word_type* w, unsigned off) const {
+        word_type v = w[0] >> off;
+        if (off + width_ > bits_per_word) {
+            v |= w[1] << (bits_per_word - off);
+        }
+        return v & low_mask(width_);
+    }
+
+    static word_type low_mask(unsigned width) {
+        return width == bits_per_word ? ~static_cast<word_type>(0) : (static_cast<word_type>(1) << width) - 1;
+    }
+
+    static size_type words(size_type n, unsigned width) {
+        return (n * width + bits_per_word - 1) / bits_per_word + 1;
+    }
+
+    static unsigned bits_for(word_type range) {
+        return range == 0 ? 0 : bits_per_word - __builtin_clzl(range);
+    }
+
+    word_type offset(value_type val) const {
+        return static_cast<word_type>(val) - static_cast<word_type>(base_);
+    }
+
+    word_type get(size_type n) const {
+        size_type bit = n * width_;
+        return extract(&words_[bit / bits_per_word], bit % bits_per_word);
+    }
+
+    void put(size_type n, word_type v) {
+        if (width_ == 0) {
+            return;
+        }
+        word_type mask = low_mask(width_);
+        size_type bit = n * width_;
+        size_type i = bit / bits_per_word;
+        unsigned off = bit % bits_per_word;
+        v &= mask;
+        words_[i] = (words_[i] & ~(mask << off)) | (v << off);
+        if (off + width_ > bits_per_word) {
+            unsigned spill = bits_per_word - off;
+            words_[i + 1] = (words_[i + 1] & ~(mask >> spill)) | (v >> spill);
+        }
+    }
+
+    // Repacks if [lo, hi] is not representable with the current base and
+    // width. Full-width elements wrap around base, so they always fit.
+    void make_fit(value_type lo, value_type hi) {
+        if (size_ == 0) {
+            base_ = lo;
+            width_ = bits_for(static_cast<word_type>(hi) - static_cast<word_type>(lo));
+            return;
+        }
+        if (width_ == value_bits || (lo >= base_ && offset(hi) <= low_mask(width_))) {
+            return;
+        }
+        for (size_type i = 0; i < size_; ++i) {
+            value_type v = (*this)[i];
+            if (v < lo) {
+                lo = v;
+            }
+            if (v > hi) {
+                hi = v;
+            }
+        }
+        unsigned width = bits_for(static_cast<word_type>(hi) - static_cast<word_type>(lo));
+        if (width <= width_) {
+            width = width_ + 1;
+        }
+        repack(lo, width < value_bits ? width : value_bits);
+    }
+
+    void repack(value_type new_base, unsigned width) {
+        packed_vector tmp;
+        tmp.words_.assign(words(size_, width), 0);
+        tmp.base_ = new_base;
+        tmp.width_ = width;
+        for (size_type i = 0; i < size_; ++i) {
+            tmp.put(i, static_cast<word_type>((*this)[i]) - static_cast<word_type>(new_base));
+        }
+        tmp.size_ = size_;
+        swap(tmp);
+    }
+
+    template <class InputIterator>
+    void init_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // Finds the range first so that every element is packed exactly once.
+    template <class ForwardIterator>
+    void init_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        if (first == last) {
+            return;
+        }
+        value_type lo = *first;
+        value_type hi = *first;
+        size_type n = 0;
+        for (ForwardIterator it = first; it != last; ++it, ++n) {
+            if (*it < lo) {
+                lo = *it;
+            }
+            if (*it > hi) {
+                hi = *it;
+            }
+        }
+        base_ = lo;
+        width_ = bits_for(static_cast<word_type>(hi) - static_cast<word_type>(lo));
+        words_.assign(words(n, width_), 0);
+        for (; first != last; ++first, ++size_) {
+            put(size_, offset(*first));
+        }
+    }
+};
+
+template <class T>
+inline void swap(packed_vector<T>& x, packed_vector<T>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "util/atomic.hpp"
+#include "util/equal.hpp"
+#include "util/index_iterator.hpp"
+
+namespace ft {
+
+// Immutable vector: set, push_back, pop_back and slice return a new version
+// and leave the old one intact. Versions share a radix-32 tree of
+// refcounted nodes, so an update copies only the O(log32 n) nodes on one path
+// and a copy is a refcount increment. Versions may be read and copied from
+// any number of threads.
+//
+// A slice is a window (origin, size) over the shared tree: it is O(1) and
+// keeps the elements outside the window alive until every version using the
+// tree is gone.
+//
+// For batches, a persistent_vector::transient built from a version owns the
+// nodes it copies and updates them in place, so each node is copied at most
+// once per batch; persistent() turns the result back into a version.
+template <class T, class Allocator = std::allocator<T> >
+class persistent_vector {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef index_iterator<const persistent_vector, const value_type> const_iterator;
+    typedef const_iterator iterator;
+
+    class transient;
+
+private:
+    static const unsigned bits = 5;
+    static const size_type width = 1 << bits;
+    static const size_type mask = width - 1;
+
+    struct node {
+        long refs;
+        // Id of the transient allowed to edit this node in place, 0 if none.
+        size_type owner;
+    };
+
+    struct branch : public node {
+        node* child[width];
+    };
+
+    struct leaf : public node {
+        size_type count;
+        char buf[width * sizeof(T)] __attribute__((__aligned__(__alignof__(T))));
+
+        T* values() { return reinterpret_cast<T*>(buf); }
+    };
+
+    typedef typename allocator_type::template rebind<branch>::other branch_allocator;
+    typedef typename allocator_type::template rebind<leaf>::other leaf_allocator;
+
+    static size_type last_owner_;
+
+    allocator_type alloc_;
+    node* root_;
+    unsigned shift_;
+    size_type origin_;
+    size_type size_;
+
+public:
+    explicit persistent_vector(const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , root_(NULL)
+        , shift_(0)
+        , origin_(0)
+        , size_(0)
+    {}
+
+    persistent_vector(const persistent_vector& x)
+        : alloc_(x.alloc_)
+        , root_(retain(x.root_))
+        , shift_(x.shift_)
+        , origin_(x.origin_)
+        , size_(x.size_)
+    {}
+
+    persistent_vector& operator=(const persistent_vector& x) {
+        persistent_vector tmp(x);
+        swap(tmp);
+        return *this;
+    }
+
+    ~persistent_vector() {
+        release(root_, shift_);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const_reference operator[](size_type n) const { return lookup(root_, shift_, origin_ + n); }
+
+    const_reference at(size_type n) const {
+        if (n >= size_) {
+            throw std::out_of_range("persistent_vector");
+        }
+        return (*this)[n];
+    }
+
+    const_reference front() const { return (*this)[0]; }
+    const_reference back() const { return (*this)[size_ - 1]; }
+
+    persistent_vector set(size_type n, const value_type& val) const {
+        persistent_vector v(*this);
+        v.assoc(origin_ + n, val, 0);
+        return v;
+    }
+
+    persistent_vector push_back(const value_type& val) const {
+        persistent_vector v(*this);
+        v.append(val, 0);
+        return v;
+    }
+
+    persistent_vector pop_back() const {
+        return slice(0, size_ - 1);
+    }
+
+    // Elements [first, last) of this version.
+    persistent_vector slice(size_type first, size_type last) const {
+        if (first > last || last > size_) {
+            throw std::out_of_range("persistent_vector");
+        }
+        persistent_vector v(alloc_);
+        if (first < last) {
+            v.root_ = retain(root_);
+            v.shift_ = shift_;
+            v.origin_ = origin_ + first;
+            v.size_ = last - first;
+        }
+        return v;
+    }
+
+    void swap(persistent_vector& x) {
+        std::swap(alloc_, x.alloc_);
+        std::swap(root_, x.root_);
+        std::swap(shift_, x.shift_);
+        std::swap(origin_, x.origin_);
+        std::swap(size_, x.size_);
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    static size_type new_owner() {
+        return atomic_fetch_add(&last_owner_, static_cast<size_type>(1)) + 1;
+    }
+
+    static node* retain(node* n) {
+        if (n != NULL) {
+            atomic_fetch_add(&n->refs, 1L);
+        }
+        return n;
+    }
+
+    void release(node* n, unsigned shift) {
+        if (n == NULL || atomic_fetch_add(&n->refs, -1L) != 1) {
+            return;
+        }
+        if (shift == 0) {
+            leaf* l = static_cast<leaf*>(n);
+            for (size_type i = 0; i < l->count; ++i) {
+                alloc_.destroy(l->values() + i);
+            }
+            leaf_allocator(alloc_).deallocate(l, 1);
+        } else {
+            branch* b = static_cast<branch*>(n);
+            for (size_type i = 0; i < width; ++i) {
+                release(b->child[i], shift - bits);
+            }
+            branch_allocator(alloc_).deallocate(b, 1);
+        }
+    }
+
+    static const_reference lookup(node* n, unsigned shift, size_type i) {
+        for (; shift > 0; shift -= bits) {
+            n = static_cast<branch*>(n)->child[(i >> shift) & mask];
+        }
+        return static_cast<leaf*>(n)->values()[i & mask];
+    }
+
+    // Returns a copy of n (or a fresh node if n is NULL) that owner may edit.
+    node* copy(node* n, unsigned shift, size_type owner) {
+        if (shift == 0) {
+            leaf* l = leaf_allocator(alloc_).allocate(1);
+            l->refs = 1;
+            l->owner = owner;
+            l->count = 0;
+            if (n != NULL) {
+                leaf* from = static_cast<leaf*>(n);
+                try {
+                    for (; l->count < from->count; ++l->count) {
+                        alloc_.construct(l->values() + l->count, from->values()[l->count]);
+                    }
+                } catch (...) {
+                    release(l, 0);
+                    throw;
+                }
+            }
+            return l;
+        }
+        branch* b = branch_allocator(alloc_).allocate(1);
+        b->refs = 1;
+        b->owner = owner;
+        for (size_type i = 0; i < width; ++i) {
+            b->child[i] = n != NULL ? retain(static_cast<branch*>(n)->child[i]) : NULL;
+        }
+        return b;
+    }
+
+    // Writes val at index i below n and returns the node to store in place
+    // of n: n itself if owner may edit it, else a copy holding one reference.
+    node* assoc(node* n, unsigned shift, size_type i, const value_type& val, size_type owner) {
+        bool editable = n != NULL && owner != 0 && n->owner == owner;
+        node* c = editable ? n : copy(n, shift, owner);
+        try {
+            if (shift == 0) {
+                leaf* l = static_cast<leaf*>(c);
+                size_type k = i & mask;
+                if (k < l->count) {
+                    l->values()[k] = val;
+                } else {
+                    alloc_.construct(l->values() + k, val);
+                    ++l->count;
+                }
+            } else {
+                node*& slot = static_cast<branch*>(c)->child[(i >> shift) & mask];
+                node* r = assoc(slot, shift - bits, i, val, owner);
+                if (r != slot) {
+                    release(slot, shift - bits);
+                    slot = r;
+                }
+            }
+        } catch (...) {
+            if (!editable) {
+                release(c, shift);
+            }
+            throw;
+        }
+        return c;
+    }
+
+    void assoc(size_type i, const value_type& val, size_type owner) {
+        node* r = assoc(root_, shift_, i, val, owner);
+        if (r != root_) {
+            release(root_, shift_);
+            root_ = r;
+        }
+    }
+
+    void append(const value_type& val, size_type owner) {
+        size_type i = origin_ + size_;
+        if (root_ != NULL && i == (width << shift_)) {
+            branch* b = static_cast<branch*>(copy(NULL, shift_ + bits, owner));
+            b->child[0] = root_;
+            root_ = b;
+            shift_ += bits;
+        }
+        assoc(i, val, owner);
+        ++size_;
+    }
+};
+
+template <class T, class Allocator>
+typename persistent_vector<T, Allocator>::size_type persistent_vector<T, Allocator>::last_owner_ = 0;
+
+// Batch editor over a persistent_vector. Nodes it copies are tagged with its
+// id and edited in place from then on; persistent() hands them to a version
+// and takes a new id, so later edits copy them again.
+template <class T, class Allocator>
+class persistent_vector<T, Allocator>::transient {
+private:
+    persistent_vector v_;
+    size_type owner_;
+
+    transient(const transient&);
+    transient& operator=(const transient&);
+
+public:
+    explicit transient(const persistent_vector& v) : v_(v), owner_(new_owner()) {}
+
+    size_type size() const { return v_.size(); }
+    const_reference operator[](size_type n) const { return v_[n]; }
+
+    void set(size_type n, const value_type& val) {
+        v_.assoc(v_.origin_ + n, val, owner_);
+    }
+
+    void push_back(const value_type& val) {
+        v_.append(val, owner_);
+    }
+
+    void pop_back() {
+        if (v_.size_ == 0) {
+            throw std::out_of_range("persistent_vector");
+        }
+        --v_.size_;
+    }
+
+    persistent_vector persistent() {
+        owner_ = new_owner();
+        return v_;
+    }
+};
+
+template <class T, class Allocator>
+inline bool operator==(const persistent_vector<T, Allocator>& x, const persistent_vector<T, Allocator>& y) {
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator>
+inline bool operator!=(const persistent_vector<T, Allocator>& x, const persistent_vector<T, Allocator>& y) {
+    return !(x == y);
+}
+
+template <class T, class Allocator>
+inline void swap(persistent_vector<T, Allocator>& x, persistent_vector<T, Allocator>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "util/dary_heap.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// Max-heap adapter like std::priority_queue, over an implicit heap with
+// Arity children per node. With the default of 4 the children of a node
+// share a cache line for small elements, and the heap is half as deep as a
+// binary one.
+template <class T, class Container = vector<T>,
+          class Compare = std::less<typename Container::value_type>, std::size_t Arity = 4>
+class priority_queue {
+public:
+    typedef Container container_type;
+    typedef Compare value_compare;
+    typedef typename container_type::value_type value_type;
+    typedef typename container_type::size_type size_type;
+    typedef typename container_type::const_reference const_reference;
+
+protected:
+    container_type c;
+    value_compare comp;
+
+public:
+    explicit priority_queue(const Compare& comp = Compare(), const Container& c = Container())
+        : c(c)
+        , comp(comp)
+    {
+        heap_make<Arity>(this->c.begin(), this->c.size(), comp, heap_no_track());
+    }
+
+    template <class InputIterator>
+    priority_queue(InputIterator first, InputIterator last,
+                   const Compare& comp = Compare(), const Container& c = Container())
+        : c(c)
+        , comp(comp)
+    {
+        this->c.insert(this->c.end(), first, last);
+        heap_make<Arity>(this->c.begin(), this->c.size(), comp, heap_no_track());
+    }
+
+    bool empty() const { return c.empty(); }
+
+    size_type size() const { return c.size(); }
+
+    const_reference top() const { return c.front(); }
+
+    void push(const value_type& v) {
+        c.push_back(v);
+        heap_sift_up<Arity>(c.begin(), c.size() - 1, comp, heap_no_track());
+    }
+
+#if __cplusplus >= 201103L
+    void push(value_type&& v) {
+        c.push_back(std::move(v));
+        heap_sift_up<Arity>(c.begin(), c.size() - 1, comp, heap_no_track());
+    }
+
+    template <class... Args>
+    void emplace(Args&&... args) {
+        c.emplace_back(std::forward<Args>(args)...);
+        heap_sift_up<Arity>(c.begin(), c.size() - 1, comp, heap_no_track());
+    }
+#endif
+
+    // Sifts each new element up, or rebuilds the heap in O(n) when the
+    // range is larger than what is already there.
+    template <class InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+        size_type n = c.size();
+        c.insert(c.end(), first, last);
+        if (c.size() - n > n) {
+            heap_make<Arity>(c.begin(), c.size(), comp, heap_no_track());
+        } else {
+            for (; n < c.size(); ++n) {
+                heap_sift_up<Arity>(c.begin(), n, comp, heap_no_track());
+            }
+        }
+    }
+
+    void pop() {
+        if (c.size() > 1) {
+#if __cplusplus >= 201103L
+            c.front() = std::move(c.back());
+#else
+            c.front() = c.back();
+#endif
+            c.pop_back();
+            heap_sift_down<Arity>(c.begin(), c.size(), 0, comp, heap_no_track());
+        } else {
+            c.pop_back();
+        }
+    }
+
+    void swap(priority_queue& x) {
+        using std::swap;
+        swap(c, x.c);
+        swap(comp, x.comp);
+    }
+};
+
+template <class T, class Container, class Compare, std::size_t Arity>
+inline void swap(priority_queue<T, Container, Compare, Arity>& x, priority_queue<T, Container, Compare, Arity>& y) {
+    x.swap(y);
+}
+
+// Max-heap whose elements can be changed or removed in O(log n) through the
+// handle push() returns. The heap keeps each priority next to its handle, so
+// sifting reads only the heap array; a second array maps handles to heap
+// indices. Handles of removed elements are reused.
+template <class T, class Compare = std::less<T>, std::size_t Arity = 4>
+class indexed_priority_queue {
+public:
+    typedef T value_type;
+    typedef Compare value_compare;
+    typedef std::size_t size_type;
+    typedef std::size_t handle_type;
+    typedef const value_type& const_reference;
+
+private:
+    struct entry {
+        value_type value;
+        handle_type handle;
+
+        entry(const value_type& v, handle_type h) : value(v), handle(h) {}
+    };
+
+    struct entry_compare {
+        value_compare comp;
+
+        explicit entry_compare(const value_compare& c) : comp(c) {}
+
+        bool operator()(const entry& x, const entry& y) const { return comp(x.value, y.value); }
+    };
+
+    struct tracker {
+        size_type* pos;
+
+        explicit tracker(size_type* p) : pos(p) {}
+
+        void operator()(const entry& e, size_type i) const { pos[e.handle] = i; }
+    };
+
+    static const size_type npos = ~static_cast<size_type>(0);
+
+    vector<entry> heap_;
+    // Heap index of each handle, npos for handles not in use.
+    vector<size_type> pos_;
+    vector<handle_type> free_;
+    value_compare comp_;
+
+public:
+    explicit indexed_priority_queue(const Compare& comp = Compare()) : comp_(comp) {}
+
+    bool empty() const { return heap_.empty(); }
+
+    size_type size() const { return heap_.size(); }
+
+    const_reference top() const { return heap_.front().value; }
+
+    handle_type top_handle() const { return heap_.front().handle; }
+
+    bool contains(handle_type h) const { return h < pos_.size() && pos_[h] != npos; }
+
+    const_reference priority(handle_type h) const { return heap_[pos_[h]].value; }
+
+    handle_type push(const value_type& v) {
+        bool fresh = free_.empty();
+        handle_type h = fresh ? pos_.size() : free_.back();
+        if (fresh) {
+            pos_.push_back(npos);
+        }
+        heap_.push_back(entry(v, h));
+        if (!fresh) {
+            free_.pop_back();
+        }
+        heap_sift_up<Arity>(heap_.begin(), heap_.size() - 1, entry_compare(comp_), tracker(&pos_[0]));
+        return h;
+    }
+
+    void pop() {
+        erase(top_handle());
+    }
+
+    // Sets the priority of h and moves it up or down to its place.
+    void update(handle_type h, const value_type& v) {
+        size_type i = pos_[h];
+        heap_[i].value = v;
+        fix(i);
+    }
+
+    void erase(handle_type h) {
+        free_.push_back(h);
+        size_type i = pos_[h];
+        pos_[h] = npos;
+        if (i + 1 == heap_.size()) {
+            heap_.pop_back();
+        } else {
+            heap_[i] = heap_.back();
+            heap_.pop_back();
+            fix(i);
+        }
+    }
+
+    void clear() {
+        heap_.clear();
+        pos_.clear();
+        free_.clear();
+    }
+
+    void swap(indexed_priority_queue& x) {
+        using std::swap;
+        heap_.swap(x.heap_);
+        pos_.swap(x.pos_);
+        free_.swap(x.free_);
+        swap(comp_, x.comp_);
+    }
+
+private:
+    void fix(size_type i) {
+        entry_compare comp(comp_);
+        if (i > 0 && comp(heap_[(i - 1) / Arity], heap_[i])) {
+            heap_sift_up<Arity>(heap_.begin(), i, comp, tracker(&pos_[0]));
+        } else {
+            heap_sift_down<Arity>(heap_.begin(), heap_.size(), i, comp, tracker(&pos_[0]));
+        }
+    }
+};
+
+template <class T, class Compare, std::size_t Arity>
+const typename indexed_priority_queue<T, Compare, Arity>::size_type indexed_priority_queue<T, Compare, Arity>::npos;
+
+template <class T, class Compare, std::size_t Arity>
+inline void swap(indexed_priority_queue<T, Compare, Arity>& x, indexed_priority_queue<T, Compare, Arity>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
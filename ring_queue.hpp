@@ -0,0 +1,389 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "util/atomic.hpp"
+
+namespace {
+
+// Smallest power of two that is at least n and at least 2.
+template <class Size>
+inline Size ring_capacity(Size n, Size max) {
+    if (n > max / 2 + 1) {
+        throw std::length_error("ring_queue");
+    }
+    Size cap = 2;
+    while (cap < n) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+} // anonymous namespace
+
+namespace ft {
+
+// Bounded FIFO for exactly one producer thread and one consumer thread.
+// Every operation is wait-free: the producer owns tail_, the consumer owns
+// head_, and each keeps a cached copy of the other's index so that it only
+// reads the shared one when the cached value says full or empty. The two
+// sides sit on separate cache lines.
+//
+// The batch forms move as many elements as fit and publish them with one
+// store, so the other side pays one cache miss per batch.
+template <class T, class Allocator = std::allocator<T> >
+class spsc_queue {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::pointer pointer;
+
+private:
+    allocator_type alloc_;
+    pointer buf_;
+    size_type mask_;
+    char pad0_[64];
+    // Written by the consumer.
+    size_type head_;
+    size_type tail_cache_;
+    char pad1_[64 - 2 * sizeof(size_type)];
+    // Written by the producer.
+    size_type tail_;
+    size_type head_cache_;
+    char pad2_[64 - 2 * sizeof(size_type)];
+
+    spsc_queue(const spsc_queue&);
+    spsc_queue& operator=(const spsc_queue&);
+
+public:
+    // Holds at least n elements; the capacity is rounded up to a power of two.
+    explicit spsc_queue(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , buf_(NULL)
+        , mask_(ring_capacity(n, alloc_.max_size()) - 1)
+        , head_(0)
+        , tail_cache_(0)
+        , tail_(0)
+        , head_cache_(0)
+    {
+        buf_ = alloc_.allocate(mask_ + 1);
+    }
+
+    ~spsc_queue() {
+        for (; head_ != tail_; ++head_) {
+            alloc_.destroy(buf_ + (head_ & mask_));
+        }
+        alloc_.deallocate(buf_, mask_ + 1);
+    }
+
+    size_type capacity() const { return mask_ + 1; }
+
+    // Snapshots: the other side may change them right after.
+    size_type size() const {
+        return atomic_load_acquire(&tail_) - atomic_load_acquire(&head_);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Producer side. Returns false if the queue is full.
+    bool try_push(const value_type& val) {
+        size_type t = tail_;
+        if (t - head_cache_ > mask_) {
+            head_cache_ = atomic_load_acquire(&head_);
+            if (t - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        alloc_.construct(buf_ + (t & mask_), val);
+        atomic_store_release(&tail_, t + 1);
+        return true;
+    }
+
+    // Producer side. Pushes a prefix of [first, last) that fits and returns
+    // the end of that prefix. If a copy throws, the elements before it stay
+    // pushed.
+    template <class InputIterator>
+    InputIterator try_push(InputIterator first, InputIterator last) {
+        size_type t = tail_;
+        size_type end = t;
+        try {
+            for (; first != last; ++first, ++end) {
+                if (end - head_cache_ > mask_) {
+                    head_cache_ = atomic_load_acquire(&head_);
+                    if (end - head_cache_ > mask_) {
+                        break;
+                    }
+                }
+                alloc_.construct(buf_ + (end & mask_), *first);
+            }
+        } catch (...) {
+            atomic_store_release(&tail_, end);
+            throw;
+        }
+        atomic_store_release(&tail_, end);
+        return first;
+    }
+
+    void push(const value_type& val) {
+        for (unsigned spins = 0; !try_push(val); ) {
+            spin_wait(spins);
+        }
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool try_pop(value_type& val) {
+        size_type h = head_;
+        if (h == tail_cache_) {
+            tail_cache_ = atomic_load_acquire(&tail_);
+            if (h == tail_cache_) {
+                return false;
+            }
+        }
+        pointer p = buf_ + (h & mask_);
+#if __cplusplus >= 201103L
+        val = std::move(*p);
+#else
+        val = *p;
+#endif
+        alloc_.destroy(p);
+        atomic_store_release(&head_, h + 1);
+        return true;
+    }
+
+    // Consumer side. Pops up to n elements into out and returns how many.
+    // If an assignment throws, that element stays at the front.
+    template <class OutputIterator>
+    size_type try_pop(OutputIterator out, size_type n) {
+        size_type h = head_;
+        if (tail_cache_ - h < n) {
+            tail_cache_ = atomic_load_acquire(&tail_);
+        }
+        size_type end = tail_cache_ - h < n ? tail_cache_ : h + n;
+        size_type i = h;
+        try {
+            for (; i != end; ++i, ++out) {
+                pointer p = buf_ + (i & mask_);
+#if __cplusplus >= 201103L
+                *out = std::move(*p);
+#else
+                *out = *p;
+#endif
+                alloc_.destroy(p);
+            }
+        } catch (...) {
+            atomic_store_release(&head_, i);
+            throw;
+        }
+        atomic_store_release(&head_, end);
+        return end - h;
+    }
+
+    void pop(value_type& val) {
+        for (unsigned spins = 0; !try_pop(val); ) {
+            spin_wait(spins);
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+};
+
+// Bounded FIFO for any number of producer and consumer threads, after
+// Dmitry Vyukov's design. Each cell carries a sequence number that says
+// whether it is ready for the producer or the consumer of a given lap, so
+// a thread claims a position with one compare-and-swap on enqueue_pos_ or
+// dequeue_pos_ and then works on its cell without further contention. The
+// two positions sit on separate cache lines.
+//
+// A batch claims a run of consecutive ready cells with a single
+// compare-and-swap. The copy constructor and assignment of value_type must
+// not throw: a claimed cell has to be handed on for the queue to make
+// progress, so such a failure calls std::terminate. This includes the batch
+// forms, which claim every cell of the batch up front; unlike spsc_queue's,
+// they cannot stop at the element that threw.
+template <class T, class Allocator = std::allocator<T> >
+class mpmc_queue {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef typename allocator_type::size_type size_type;
+    typedef typename allocator_type::difference_type difference_type;
+
+private:
+    struct cell {
+        size_type seq;
+        char buf[sizeof(T)] __attribute__((__aligned__(__alignof__(T))));
+
+        T* value() { return reinterpret_cast<T*>(buf); }
+    };
+
+    typedef typename allocator_type::template rebind<cell>::other cell_allocator;
+
+    allocator_type alloc_;
+    cell* cells_;
+    size_type mask_;
+    char pad0_[64];
+    size_type enqueue_pos_;
+    char pad1_[64 - sizeof(size_type)];
+    size_type dequeue_pos_;
+    char pad2_[64 - sizeof(size_type)];
+
+    mpmc_queue(const mpmc_queue&);
+    mpmc_queue& operator=(const mpmc_queue&);
+
+public:
+    // Holds at least n elements; the capacity is rounded up to a power of two.
+    explicit mpmc_queue(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_(alloc)
+        , cells_(NULL)
+        , mask_(ring_capacity(n, cell_allocator(alloc).max_size()) - 1)
+        , enqueue_pos_(0)
+        , dequeue_pos_(0)
+    {
+        cells_ = cell_allocator(alloc_).allocate(mask_ + 1);
+        for (size_type i = 0; i <= mask_; ++i) {
+            cells_[i].seq = i;
+        }
+    }
+
+    ~mpmc_queue() {
+        for (; dequeue_pos_ != enqueue_pos_; ++dequeue_pos_) {
+            alloc_.destroy(cells_[dequeue_pos_ & mask_].value());
+        }
+        cell_allocator(alloc_).deallocate(cells_, mask_ + 1);
+    }
+
+    size_type capacity() const { return mask_ + 1; }
+
+    // Snapshot; counts elements whose producers are still copying them.
+    size_type size() const {
+        size_type d = atomic_load_acquire(&dequeue_pos_);
+        size_type e = atomic_load_acquire(&enqueue_pos_);
+        return e - d > mask_ ? 0 : e - d;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Returns false if the queue is full.
+    bool try_push(const value_type& val) {
+        size_type pos;
+        if (claim(&enqueue_pos_, 0, 1, pos) == 0) {
+            return false;
+        }
+        fill(pos, val);
+        return true;
+    }
+
+    // Pushes a prefix of [first, last) that fits and returns the end of
+    // that prefix.
+    template <class ForwardIterator>
+    ForwardIterator try_push(ForwardIterator first, ForwardIterator last) {
+        size_type pos;
+        size_type n = claim(&enqueue_pos_, 0, static_cast<size_type>(std::distance(first, last)), pos);
+        for (; n > 0; --n, ++pos, ++first) {
+            fill(pos, *first);
+        }
+        return first;
+    }
+
+    void push(const value_type& val) {
+        for (unsigned spins = 0; !try_push(val); ) {
+            spin_wait(spins);
+        }
+    }
+
+    // Returns false if the queue is empty.
+    bool try_pop(value_type& val) {
+        size_type pos;
+        if (claim(&dequeue_pos_, 1, 1, pos) == 0) {
+            return false;
+        }
+        take(pos, &val);
+        return true;
+    }
+
+    // Pops up to n elements into out and returns how many.
+    template <class OutputIterator>
+    size_type try_pop(OutputIterator out, size_type n) {
+        size_type pos;
+        size_type count = claim(&dequeue_pos_, 1, n, pos);
+        for (size_type i = 0; i < count; ++i, ++out) {
+            take(pos + i, out);
+        }
+        return count;
+    }
+
+    void pop(value_type& val) {
+        for (unsigned spins = 0; !try_pop(val); ) {
+            spin_wait(spins);
+        }
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_;
+    }
+
+private:
+    // Claims up to n consecutive cells that are ready for one side and
+    // returns how many, with the first position in pos. The cell for
+    // position p is ready for producers when its sequence is p and for
+    // consumers when it is p + 1; ready is that offset.
+    size_type claim(size_type* counter, size_type ready, size_type n, size_type& pos) {
+        pos = atomic_load_relaxed(counter);
+        for (;;) {
+            size_type k = 0;
+            bool behind = false;
+            for (; k < n && k <= mask_; ++k) {
+                size_type seq = atomic_load_acquire(&cells_[(pos + k) & mask_].seq);
+                difference_type diff = static_cast<difference_type>(seq - (pos + k + ready));
+                if (diff != 0) {
+                    // A later sequence at pos means another thread claimed it.
+                    behind = k == 0 && diff > 0;
+                    break;
+                }
+            }
+            if (behind) {
+                pos = atomic_load_relaxed(counter);
+            } else if (k == 0) {
+                return 0;
+            } else if (atomic_compare_exchange(counter, &pos, pos + k)) {
+                return k;
+            }
+        }
+    }
+
+    void fill(size_type pos, const value_type& val) {
+        cell& c = cells_[pos & mask_];
+        try {
+            alloc_.construct(c.value(), val);
+        } catch (...) {
+            std::terminate();
+        }
+        atomic_store_release(&c.seq, pos + 1);
+    }
+
+    template <class OutputIterator>
+    void take(size_type pos, OutputIterator out) {
+        cell& c = cells_[pos & mask_];
+        try {
+#if __cplusplus >= 201103L
+            *out = std::move(*c.value());
+#else
+            *out = *c.value();
+#endif
+        } catch (...) {
+            std::terminate();
+        }
+        alloc_.destroy(c.value());
+        atomic_store_release(&c.seq, pos + mask_ + 1);
+    }
+};
+
+} // namespace ft
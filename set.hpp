@@ -2,9 +2,15 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
+
+#if __cplusplus >= 201103L
+    #include <type_traits>
+#endif
 
 #include "util/equal.hpp"
 #include "util/lexicographical_compare.hpp"
+#include "util/pool_allocator.hpp"
 #include "util/reverse_iterator.hpp"
 #include "util/tree.hpp"
 
@@ -65,6 +71,16 @@ public:
         return *this;
     }
 
+#if __cplusplus >= 201103L
+    set(set&& s) noexcept(std::is_nothrow_move_constructible<tree_type>::value)
+        : tree_(std::move(s.tree_)) {}
+
+    set& operator=(set&& s) noexcept(std::is_nothrow_move_assignable<tree_type>::value) {
+        tree_ = std::move(s.tree_);
+        return *this;
+    }
+#endif
+
     allocator_type get_allocator() const { return tree_.get_allocator(); }
 
     iterator begin() { return tree_.begin(); }
@@ -89,6 +105,26 @@ public:
         return tree_.insert_unique(hint, v);
     }
 
+#if __cplusplus >= 201103L
+    pair<iterator, bool> insert(value_type&& v) {
+        return tree_.__insert_unique(std::move(v));
+    }
+
+    iterator insert(iterator hint, value_type&& v) {
+        return tree_.__insert_unique(hint, std::move(v));
+    }
+
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.__emplace_unique(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_hint(iterator hint, Args&&... args) {
+        return tree_.__emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+#endif
+
     template <class InputIterator>
     void insert(InputIterator first, InputIterator last) {
         for (iterator e = end(); first != last; ++first) {
@@ -134,7 +170,7 @@ template <class Key, class Compare, class Allocator>
 bool operator==(const set<Key, Compare, Allocator>& x,
                 const set<Key, Compare, Allocator>& y)
 {
-    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+    return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 }
 
 template <class Key, class Compare, class Allocator>
@@ -148,7 +184,7 @@ template <class Key, class Compare, class Allocator>
 bool operator<(const set<Key, Compare, Allocator>& x,
                const set<Key, Compare, Allocator>& y)
 {
-    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
 template <class Key, class Compare, class Allocator>
@@ -179,4 +215,11 @@ void swap(const set<Key, Compare, Allocator>& x,
     x.swap(y);
 }
 
+// A set whose nodes come from pool_allocator:
+//     ft::pool_set<int>::type s;
+template <class Key, class Compare = std::less<Key> >
+struct pool_set {
+    typedef set<Key, Compare, pool_allocator<Key> > type;
+};
+
 } // namespace ft
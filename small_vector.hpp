@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "vector.hpp"
+
+namespace ft {
+
+// Hands out its inline buffer for an allocation of at most N elements while
+// the buffer is free and falls back to std::allocator otherwise. Copies
+// start with an unused buffer, so an allocator is never shared between two
+// containers.
+template <class T, std::size_t N>
+class small_vector_allocator : public std::allocator<T> {
+private:
+    typedef std::allocator<T> base;
+
+public:
+    typedef typename base::pointer pointer;
+    typedef typename base::const_pointer const_pointer;
+    typedef typename base::size_type size_type;
+
+    template <class U>
+    struct rebind {
+        typedef small_vector_allocator<U, N> other;
+    };
+
+    small_vector_allocator() : base(), used_(false) {}
+
+    small_vector_allocator(const small_vector_allocator&) : base(), used_(false) {}
+
+    template <class U>
+    small_vector_allocator(const small_vector_allocator<U, N>&) : base(), used_(false) {}
+
+    pointer allocate(size_type n) {
+        if (n <= N && !used_) {
+            used_ = true;
+            return inline_begin();
+        }
+        return base::allocate(n);
+    }
+
+    void deallocate(pointer p, size_type n) {
+        if (p == inline_begin()) {
+            used_ = false;
+        } else {
+            base::deallocate(p, n);
+        }
+    }
+
+    bool is_inline(const_pointer p) const {
+        return p == reinterpret_cast<const_pointer>(buf_);
+    }
+
+private:
+    pointer inline_begin() {
+        return reinterpret_cast<pointer>(buf_);
+    }
+
+    small_vector_allocator& operator=(const small_vector_allocator&);
+
+    char buf_[N * sizeof(T)] __attribute__((__aligned__(__alignof__(T))));
+    bool used_;
+};
+
+template <class T, std::size_t N>
+void swap(small_vector_allocator<T, N>&, small_vector_allocator<T, N>&) {}
+
+// A vector that starts out with capacity N in an inline buffer and only moves
+// to the heap once it grows past that.
+template <class T, std::size_t N>
+class small_vector : public vector<T, small_vector_allocator<T, N> > {
+private:
+    typedef vector<T, small_vector_allocator<T, N> > base;
+
+public:
+    typedef typename base::value_type value_type;
+    typedef typename base::size_type size_type;
+
+    static const size_type inline_capacity = N;
+
+    small_vector() : base() {
+        this->vallocate(N);
+    }
+
+    explicit small_vector(size_type n, const value_type& val = value_type())
+        : base()
+    {
+        this->vallocate(N);
+        this->assign(n, val);
+    }
+
+    template <class InputIterator>
+    small_vector(InputIterator first, InputIterator last,
+                 typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+        : base()
+    {
+        this->vallocate(N);
+        this->assign(first, last);
+    }
+
+    small_vector(const small_vector& x) : base() {
+        this->vallocate(N);
+        this->assign(x.begin(), x.end());
+    }
+
+    small_vector& operator=(const small_vector& x) {
+        base::operator=(x);
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    small_vector(small_vector&& x) : base() {
+        this->vallocate(N);
+        swap(x);
+    }
+
+    small_vector& operator=(small_vector&& x) {
+        if (this != &x) {
+            this->clear();
+            swap(x);
+        }
+        return *this;
+    }
+#endif
+
+    bool is_inline() const {
+        return this->alloc_.is_inline(this->begin_);
+    }
+
+    void swap(small_vector& x) {
+        if (!is_inline() && !x.is_inline()) {
+            base::swap(x);
+        } else if (is_inline() && x.is_inline()) {
+            small_vector tmp(*this);
+            *this = x;
+            x = tmp;
+        } else if (is_inline()) {
+            x.swap(*this);
+        } else {
+            typename base::pointer b = this->begin_;
+            typename base::pointer e = this->end_;
+            typename base::pointer c = this->end_cap_;
+            this->vallocate(N);
+            try {
+                this->construct_at_end(x.begin_, x.end_);
+            } catch (...) {
+                this->destruct_at_end(this->begin_);
+                this->alloc_.deallocate(this->begin_, N);
+                this->begin_ = b;
+                this->end_ = e;
+                this->end_cap_ = c;
+                throw;
+            }
+            x.vdeallocate();
+            x.begin_ = b;
+            x.end_ = e;
+            x.end_cap_ = c;
+        }
+    }
+};
+
+template <class T, std::size_t N>
+inline void swap(small_vector<T, N>& x, small_vector<T, N>& y) {
+    x.swap(y);
+}
+
+} // namespace ft
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility>
+
 #include "vector.hpp"
 
 namespace ft {
@@ -17,6 +19,10 @@ protected:
 public:
     explicit stack(const Container& c = Container()) : c(c) {}
 
+#if __cplusplus >= 201103L
+    explicit stack(Container&& c) : c(std::move(c)) {}
+#endif
+
     bool empty() const { return c.empty(); }
 
     size_type size() const { return c.size(); }
@@ -27,8 +33,24 @@ public:
 
     void push(const value_type& v) { c.push_back(v); }
 
+#if __cplusplus >= 201103L
+    void push(value_type&& v) { c.push_back(std::move(v)); }
+
+    template <class... Args>
+    void emplace(Args&&... args) { c.emplace_back(std::forward<Args>(args)...); }
+#endif
+
     void pop() { c.pop_back(); }
 
+    template <class InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+        c.insert(c.end(), first, last);
+    }
+
+    void pop_n(size_type n) {
+        c.erase(c.end() - n, c.end());
+    }
+
     template <class T1, class C1>
     friend bool operator==(const stack<T1, C1>& x, const stack<T1, C1>& y);
 
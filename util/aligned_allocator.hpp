@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "growth_policy.hpp"
+
+namespace ft {
+
+// Hands out blocks aligned to Align bytes whose size is rounded up to a whole
+// number of Align bytes, so SIMD kernels may load and store full registers
+// past the last element without leaving the block. Every block is padded
+// this way, including those of reserve(n) and vector(n); only growth also
+// reports the padding as capacity (see vector_growth below). Align must be a
+// power of two and at least sizeof(void*), e.g. 32 (AVX2), 64 (AVX-512,
+// cache line) or 4096 (page).
+template <class T, std::size_t Align = 64>
+class aligned_allocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type alignment = Align;
+
+    template <class U>
+    struct rebind {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+    aligned_allocator() {}
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        void* p;
+        if (::posix_memalign(&p, Align, (n * sizeof(T) + Align - 1) & ~(Align - 1)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type) {
+        std::free(p);
+    }
+
+    size_type max_size() const {
+        return (std::numeric_limits<size_type>::max() - Align) / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference val) {
+        ::new (static_cast<void*>(p)) T(val);
+    }
+
+    void destroy(pointer p) {
+        p->~T();
+    }
+
+private:
+    typedef char power_of_two_alignment_only[(Align & (Align - 1)) == 0 && Align >= sizeof(void*) ? 1 : -1];
+};
+
+template <class T, class U, std::size_t Align>
+bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+    return true;
+}
+
+template <class T, class U, std::size_t Align>
+bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+    return false;
+}
+
+// A vector over aligned storage grows to whole 64-byte registers (or whole
+// Align blocks when smaller), so that push_back fills the padding before it
+// reallocates. Capacity set by reserve(n) or vector(n) stays exactly n.
+template <class T, std::size_t Align>
+struct vector_growth<T, aligned_allocator<T, Align> >
+    : public growth_padded<(Align < 64 ? Align : 64)> {};
+
+} // namespace ft
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <sched.h>
+
+namespace {
+
+template <class T>
+inline T atomic_load_relaxed(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+template <class T>
+inline T atomic_load_acquire(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template <class T>
+inline void atomic_store_relaxed(T* p, T v) {
+    __atomic_store_n(p, v, __ATOMIC_RELAXED);
+}
+
+template <class T>
+inline void atomic_store_release(T* p, T v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+template <class T>
+inline T atomic_fetch_add(T* p, T v) {
+    return __atomic_fetch_add(p, v, __ATOMIC_ACQ_REL);
+}
+
+// On failure *expected receives the current value.
+template <class T>
+inline bool atomic_compare_exchange(T* p, T* expected, T desired) {
+    return __atomic_compare_exchange_n(p, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// Full barrier: orders earlier stores before later loads, which acquire and
+// release alone do not.
+inline void atomic_fence() {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Spins briefly, then yields so that a preempted thread we wait on can run.
+inline void spin_wait(unsigned& spins) {
+    if (++spins < 64) {
+        cpu_relax();
+    } else {
+        sched_yield();
+    }
+}
+
+} // anonymous namespace
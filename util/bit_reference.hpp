@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+namespace ft {
+
+// Proxy for one bit of a Word, returned where a bool& would be.
+template <class Word>
+class bit_reference {
+private:
+    Word* w;
+    Word mask;
+
+public:
+    bit_reference(Word* w, Word mask) : w(w), mask(mask) {}
+
+    bit_reference(const bit_reference& x) : w(x.w), mask(x.mask) {}
+
+    operator bool() const { return (*w & mask) != 0; }
+    bool operator~() const { return (*w & mask) == 0; }
+
+    bit_reference& operator=(bool x) {
+        if (x) {
+            *w |= mask;
+        } else {
+            *w &= ~mask;
+        }
+        return *this;
+    }
+
+    bit_reference& operator=(const bit_reference& x) {
+        return *this = static_cast<bool>(x);
+    }
+
+    void flip() { *w ^= mask; }
+};
+
+template <class Word>
+inline void swap(bit_reference<Word> x, bit_reference<Word> y) {
+    bool t = x;
+    x = y;
+    y = t;
+}
+
+namespace {
+
+template <class Word, bool Const>
+struct bit_iterator_types {
+    typedef bit_reference<Word> reference;
+};
+
+template <class Word>
+struct bit_iterator_types<Word, true> {
+    typedef bool reference;
+};
+
+} // anonymous namespace
+
+// Random-access iterator over packed bits: a word and a bit index in it.
+template <class Word, bool Const>
+class bit_iterator {
+private:
+    static const unsigned bits_per_word = sizeof(Word) * 8;
+
+    Word* w;
+    unsigned bit;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef bool value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef typename bit_iterator_types<Word, Const>::reference reference;
+
+    bit_iterator() : w(NULL), bit(0) {}
+
+    bit_iterator(Word* w, unsigned bit) : w(w), bit(bit) {}
+
+    bit_iterator(const bit_iterator<Word, false>& u) : w(u.w), bit(u.bit) {}
+
+    reference operator*() const { return bit_reference<Word>(w, static_cast<Word>(1) << bit); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    bit_iterator& operator++() {
+        if (++bit == bits_per_word) {
+            bit = 0;
+            ++w;
+        }
+        return *this;
+    }
+
+    bit_iterator operator++(int) {
+        bit_iterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    bit_iterator& operator--() {
+        if (bit-- == 0) {
+            bit = bits_per_word - 1;
+            --w;
+        }
+        return *this;
+    }
+
+    bit_iterator operator--(int) {
+        bit_iterator tmp(*this);
+        --*this;
+        return tmp;
+    }
+
+    bit_iterator& operator+=(difference_type n) {
+        difference_type b = static_cast<difference_type>(bit) + n;
+        difference_type d = b >= 0 ? b / static_cast<difference_type>(bits_per_word)
+                                   : -((-b - 1) / static_cast<difference_type>(bits_per_word)) - 1;
+        w += d;
+        bit = static_cast<unsigned>(b - d * static_cast<difference_type>(bits_per_word));
+        return *this;
+    }
+
+    bit_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    bit_iterator operator+(difference_type n) const {
+        bit_iterator tmp(*this);
+        return tmp += n;
+    }
+
+    bit_iterator operator-(difference_type n) const {
+        bit_iterator tmp(*this);
+        return tmp -= n;
+    }
+
+    friend bit_iterator operator+(difference_type n, const bit_iterator& x) { return x + n; }
+
+    friend difference_type operator-(const bit_iterator& x, const bit_iterator& y) {
+        return (x.w - y.w) * static_cast<difference_type>(bits_per_word)
+               + static_cast<difference_type>(x.bit) - static_cast<difference_type>(y.bit);
+    }
+
+    friend bool operator==(const bit_iterator& x, const bit_iterator& y) { return x.w == y.w && x.bit == y.bit; }
+    friend bool operator!=(const bit_iterator& x, const bit_iterator& y) { return !(x == y); }
+    friend bool operator<(const bit_iterator& x, const bit_iterator& y) { return x - y < 0; }
+    friend bool operator>(const bit_iterator& x, const bit_iterator& y) { return y < x; }
+    friend bool operator<=(const bit_iterator& x, const bit_iterator& y) { return !(y < x); }
+    friend bool operator>=(const bit_iterator& x, const bit_iterator& y) { return !(x < y); }
+
+    friend class bit_iterator<Word, true>;
+};
+
+} // namespace ft
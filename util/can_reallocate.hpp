@@ -0,0 +1,14 @@
+#pragma once
+
+#include "integral_constant.hpp"
+
+namespace ft {
+
+// Allocators that can resize a block in place of allocate/copy/deallocate
+// provide pointer reallocate(pointer p, size_type old_n, size_type new_n),
+// which keeps the bytes of the first min(old_n, new_n) elements, and
+// specialize this trait to true_type.
+template <class Allocator>
+struct can_reallocate : public false_type {};
+
+} // namespace ft
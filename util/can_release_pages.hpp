@@ -0,0 +1,14 @@
+#pragma once
+
+#include "integral_constant.hpp"
+
+namespace ft {
+
+// Allocators that can hand the memory behind part of a block back to the OS
+// without moving it provide void release(pointer p, size_type n, size_type from),
+// which drops the whole pages past element `from` of the n-element block p,
+// and specialize this trait to true_type.
+template <class Allocator>
+struct can_release_pages : public false_type {};
+
+} // namespace ft
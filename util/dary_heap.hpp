@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Implicit heap with Arity children per node: the children of i are
+// i * Arity + 1 ... i * Arity + Arity. A wider node makes the heap shallower
+// and puts all children of a node in one or two cache lines, so sift-down
+// takes one miss per level instead of one per comparison. Elements move
+// into a hole rather than being swapped, and track(element, index) is
+// called for every element that lands at a new index.
+
+struct heap_no_track {
+    template <class V, class Size>
+    void operator()(const V&, Size) const {}
+};
+
+template <std::size_t Arity, class RandomAccessIterator, class Compare, class Track>
+void heap_sift_up(RandomAccessIterator first, std::size_t i, Compare comp, Track track) {
+#if __cplusplus >= 201103L
+    typename std::iterator_traits<RandomAccessIterator>::value_type v(std::move(first[i]));
+#else
+    typename std::iterator_traits<RandomAccessIterator>::value_type v(first[i]);
+#endif
+    while (i > 0) {
+        std::size_t parent = (i - 1) / Arity;
+        if (!comp(first[parent], v)) {
+            break;
+        }
+#if __cplusplus >= 201103L
+        first[i] = std::move(first[parent]);
+#else
+        first[i] = first[parent];
+#endif
+        track(first[i], i);
+        i = parent;
+    }
+#if __cplusplus >= 201103L
+    first[i] = std::move(v);
+#else
+    first[i] = v;
+#endif
+    track(first[i], i);
+}
+
+template <std::size_t Arity, class RandomAccessIterator, class Compare, class Track>
+void heap_sift_down(RandomAccessIterator first, std::size_t n, std::size_t i, Compare comp, Track track) {
+#if __cplusplus >= 201103L
+    typename std::iterator_traits<RandomAccessIterator>::value_type v(std::move(first[i]));
+#else
+    typename std::iterator_traits<RandomAccessIterator>::value_type v(first[i]);
+#endif
+    for (;;) {
+        std::size_t child = i * Arity + 1;
+        if (child >= n) {
+            break;
+        }
+        std::size_t last = n - child < Arity ? n : child + Arity;
+        std::size_t best = child;
+        for (++child; child < last; ++child) {
+            if (comp(first[best], first[child])) {
+                best = child;
+            }
+        }
+        if (!comp(v, first[best])) {
+            break;
+        }
+#if __cplusplus >= 201103L
+        first[i] = std::move(first[best]);
+#else
+        first[i] = first[best];
+#endif
+        track(first[i], i);
+        i = best;
+    }
+#if __cplusplus >= 201103L
+    first[i] = std::move(v);
+#else
+    first[i] = v;
+#endif
+    track(first[i], i);
+}
+
+// Floyd's bottom-up construction, O(n).
+template <std::size_t Arity, class RandomAccessIterator, class Compare, class Track>
+void heap_make(RandomAccessIterator first, std::size_t n, Compare comp, Track track) {
+    if (n < 2) {
+        for (std::size_t i = 0; i < n; ++i) {
+            track(first[i], i);
+        }
+        return;
+    }
+    for (std::size_t i = n - 1; i > (n - 2) / Arity; --i) {
+        track(first[i], i);
+    }
+    for (std::size_t i = (n - 2) / Arity + 1; i > 0; --i) {
+        heap_sift_down<Arity>(first, n, i - 1, comp, track);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace ft {
+
+// Tag requesting default- rather than value-initialization of new elements,
+// which leaves trivially constructible elements uninitialized.
+struct default_init_t {};
+
+const default_init_t default_init = default_init_t();
+
+} // namespace ft
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstring>
+
+#include "enable_if.hpp"
 #include "iterator_traits.hpp"
+#include "mismatch_bytes.hpp"
+#include "wrap_iter.hpp"
 
 namespace {
 
@@ -47,7 +52,21 @@ bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
 {
     typedef typename iterator_traits<InputIterator1>::value_type v1;
     typedef typename iterator_traits<InputIterator2>::value_type v2;
-    return equal(first1, last1, first2, equal_to<v1, v2>());
+    return ft::equal(first1, last1, first2, equal_to<v1, v2>());
+}
+
+template <class T1, class T2>
+typename enable_if<is_byte_comparable<T1, T2>::value, bool>::type
+equal(T1* first1, T1* last1, T2* first2)
+{
+    return first1 == last1 || std::memcmp(first1, first2, (last1 - first1) * sizeof(T1)) == 0;
+}
+
+template <class T1, class T2>
+typename enable_if<is_byte_comparable<T1, T2>::value, bool>::type
+equal(wrap_iter<T1*> first1, wrap_iter<T1*> last1, wrap_iter<T2*> first2)
+{
+    return ft::equal(first1.base(), last1.base(), first2.base());
 }
 
 } // namespace ft
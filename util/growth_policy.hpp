@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#if defined(__APPLE__)
+    #include <malloc/malloc.h>
+#endif
+
+namespace ft {
+
+// A growth policy maps the current capacity and the required size n
+// (n > cap, n <= max) to the new capacity, which must lie in [n, max].
+
+struct growth_double {
+    template <class T>
+    static std::size_t recommend(std::size_t cap, std::size_t n, std::size_t max) {
+        if (cap >= max / 2) {
+            return max;
+        }
+        return cap * 2 > n ? cap * 2 : n;
+    }
+};
+
+struct growth_one_and_half {
+    template <class T>
+    static std::size_t recommend(std::size_t cap, std::size_t n, std::size_t max) {
+        if (cap >= max / 3 * 2) {
+            return max;
+        }
+        std::size_t c = cap + cap / 2;
+        return c > n ? c : n;
+    }
+};
+
+// Size classes map a request of bytes to the number of bytes the
+// allocator really hands out for it.
+
+// No rounding; for allocators whose blocks are exactly the requested size.
+struct exact_size_class {
+    static std::size_t usable_size(std::size_t bytes) {
+        return bytes;
+    }
+};
+
+// The system malloc: malloc_good_size on Apple, a model of glibc's chunk
+// layout on glibc, and no rounding elsewhere. It is only right when the
+// blocks really come from that malloc; pass another size class for
+// jemalloc (nallocx), tcmalloc (nallocx) or the allocators in util/.
+struct malloc_size_class {
+    static std::size_t usable_size(std::size_t bytes) {
+#if defined(__APPLE__)
+        return ::malloc_good_size(bytes);
+#elif defined(__GLIBC__)
+        // Chunks carry an 8-byte header and are 16-byte aligned with a
+        // 32-byte minimum; requests past the mmap threshold get whole pages.
+        static const std::size_t mmap_threshold = 128 * 1024;
+        static const std::size_t page = 4096;
+        if (bytes + 16 >= mmap_threshold) {
+            return ((bytes + 16 + page - 1) & ~(page - 1)) - 16;
+        }
+        std::size_t chunk = (bytes + 8 + 15) & ~static_cast<std::size_t>(15);
+        return (chunk < 32 ? 32 : chunk) - 8;
+#else
+        return bytes;
+#endif
+    }
+};
+
+// Grows like Base, then rounds the block up to what SizeClass says the
+// allocator hands out for it, so the slack it keeps anyway becomes capacity.
+template <class Base = growth_double, class SizeClass = malloc_size_class>
+struct growth_size_class {
+    template <class T>
+    static std::size_t recommend(std::size_t cap, std::size_t n, std::size_t max) {
+        std::size_t c = Base::template recommend<T>(cap, n, max);
+        if (c >= max) {
+            return max;
+        }
+        std::size_t fit = SizeClass::usable_size(c * sizeof(T)) / sizeof(T);
+        return fit < max ? fit : max;
+    }
+};
+
+// Grows like Base, then rounds the capacity up to as many elements as fit in
+// the whole number of Bytes-wide blocks (e.g. SIMD registers) it touches.
+template <std::size_t Bytes, class Base = growth_double>
+struct growth_padded {
+    template <class T>
+    static std::size_t recommend(std::size_t cap, std::size_t n, std::size_t max) {
+        std::size_t c = Base::template recommend<T>(cap, n, max);
+        if (c >= max || c > (std::numeric_limits<std::size_t>::max() - Bytes) / sizeof(T)) {
+            return c;
+        }
+        std::size_t padded = (c * sizeof(T) + Bytes - 1) / Bytes * Bytes / sizeof(T);
+        return padded < max ? padded : max;
+    }
+};
+
+// Selects the growth policy of vector<T, Allocator>. Specialize it to trade
+// reallocation count against slack for a given element type, e.g.
+//
+//     namespace ft {
+//     template <> struct vector_growth<Record, std::allocator<Record> >
+//         : public growth_one_and_half {};
+//     }
+template <class T, class Allocator>
+struct vector_growth : public growth_double {};
+
+} // namespace ft
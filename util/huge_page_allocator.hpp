@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "can_release_pages.hpp"
+#include "slab_pool.hpp"
+
+namespace {
+
+const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+inline std::size_t huge_page_round(std::size_t bytes) {
+    return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+// Maps bytes (a multiple of huge_page_size) at a huge-page aligned address
+// by over-mapping one huge page and trimming both ends.
+inline void* map_huge_pages(std::size_t bytes) {
+    std::size_t len = bytes + huge_page_size;
+    void* raw = ::mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    char* first = static_cast<char*>(raw);
+    char* aligned = reinterpret_cast<char*>(huge_page_round(reinterpret_cast<std::size_t>(first)));
+    if (aligned != first) {
+        ::munmap(first, aligned - first);
+    }
+    std::size_t tail = (first + len) - (aligned + bytes);
+    if (tail > 0) {
+        ::munmap(aligned + bytes, tail);
+    }
+#if defined(MADV_HUGEPAGE)
+    ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+// Slabs for slab_pool: one huge page each.
+struct huge_page_slabs {
+    static const std::size_t slab_size = huge_page_size;
+
+    static void* allocate() {
+        return map_huge_pages(huge_page_size);
+    }
+};
+
+} // anonymous namespace
+
+namespace ft {
+
+// Backs blocks of at least Threshold bytes with 2 MiB aligned mappings marked
+// MADV_HUGEPAGE, and single objects of up to small_object_limit bytes (tree
+// nodes) with slots from huge-page slabs, so both large vectors and node
+// based containers need fewer TLB entries. Everything else uses operator new.
+template <class T, std::size_t Threshold = 2 * 1024 * 1024>
+class huge_page_allocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef huge_page_allocator<U, Threshold> other;
+    };
+
+    static const size_type small_object_limit = 256;
+
+    huge_page_allocator() {}
+
+    template <class U>
+    huge_page_allocator(const huge_page_allocator<U, Threshold>&) {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        if (n == 1 && slot_size <= small_object_limit) {
+            return static_cast<pointer>(pool::allocate());
+        }
+        size_type bytes = n * sizeof(T);
+        if (bytes < Threshold) {
+            return static_cast<pointer>(::operator new(bytes));
+        }
+        return static_cast<pointer>(map_huge_pages(huge_page_round(bytes)));
+    }
+
+    void deallocate(pointer p, size_type n) {
+        if (n == 1 && slot_size <= small_object_limit) {
+            pool::deallocate(p);
+            return;
+        }
+        size_type bytes = n * sizeof(T);
+        if (bytes < Threshold) {
+            ::operator delete(p);
+        } else {
+            ::munmap(p, huge_page_round(bytes));
+        }
+    }
+
+    void release(pointer p, size_type n, size_type from) {
+        size_type bytes = n * sizeof(T);
+        if ((n == 1 && slot_size <= small_object_limit) || bytes < Threshold) {
+            return;
+        }
+        static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        size_type first = (from * sizeof(T) + page - 1) & ~(page - 1);
+        size_type last = huge_page_round(bytes);
+        if (first < last) {
+            ::madvise(reinterpret_cast<char*>(p) + first, last - first, MADV_DONTNEED);
+        }
+    }
+
+    size_type max_size() const {
+        return std::numeric_limits<size_type>::max() / 2 / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference val) {
+        ::new (static_cast<void*>(p)) T(val);
+    }
+
+    void destroy(pointer p) {
+        p->~T();
+    }
+
+private:
+    static const size_type slot_align = __alignof__(T) > 16 ? __alignof__(T) : 16;
+    static const size_type slot_size = (sizeof(T) + slot_align - 1) / slot_align * slot_align;
+
+    typedef slab_pool<slot_size, huge_page_slabs> pool;
+};
+
+template <class T, class U, std::size_t Threshold>
+bool operator==(const huge_page_allocator<T, Threshold>&, const huge_page_allocator<U, Threshold>&) {
+    return true;
+}
+
+template <class T, class U, std::size_t Threshold>
+bool operator!=(const huge_page_allocator<T, Threshold>&, const huge_page_allocator<U, Threshold>&) {
+    return false;
+}
+
+template <class T, std::size_t Threshold>
+struct can_release_pages<huge_page_allocator<T, Threshold> > : public true_type {};
+
+} // namespace ft
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+namespace {
+
+// Random-access iterator over any container with operator[], for containers
+// whose elements are not contiguous. It holds the container and an index, so
+// it stays valid while the container grows. Containers that decode their
+// elements on access pass Value as Reference to iterate by value.
+template <class Container, class Value, class Reference = Value&>
+class index_iterator {
+private:
+    Container* c;
+    typename Container::size_type i;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename Container::value_type value_type;
+    typedef typename Container::difference_type difference_type;
+    typedef Value* pointer;
+    typedef Reference reference;
+
+    index_iterator() : c(NULL), i(0) {}
+
+    index_iterator(Container* x, typename Container::size_type n) : c(x), i(n) {}
+
+    template <class C, class V, class R>
+    index_iterator(const index_iterator<C, V, R>& u) : c(u.c), i(u.i) {}
+
+    reference operator*() const { return (*c)[i]; }
+    pointer operator->() const { return &(*c)[i]; }
+    reference operator[](difference_type n) const { return (*c)[i + n]; }
+
+    index_iterator& operator++() {
+        ++i;
+        return *this;
+    }
+
+    index_iterator operator++(int) {
+        index_iterator tmp(*this);
+        ++i;
+        return tmp;
+    }
+
+    index_iterator& operator--() {
+        --i;
+        return *this;
+    }
+
+    index_iterator operator--(int) {
+        index_iterator tmp(*this);
+        --i;
+        return tmp;
+    }
+
+    index_iterator& operator+=(difference_type n) {
+        i += n;
+        return *this;
+    }
+
+    index_iterator& operator-=(difference_type n) {
+        i -= n;
+        return *this;
+    }
+
+    index_iterator operator+(difference_type n) const {
+        return index_iterator(c, i + n);
+    }
+
+    index_iterator operator-(difference_type n) const {
+        return index_iterator(c, i - n);
+    }
+
+    friend index_iterator operator+(difference_type n, const index_iterator& x) {
+        return x + n;
+    }
+
+    template <class C, class V, class R>
+    difference_type operator-(const index_iterator<C, V, R>& y) const {
+        return static_cast<difference_type>(i) - static_cast<difference_type>(y.i);
+    }
+
+    template <class C, class V, class R>
+    bool operator==(const index_iterator<C, V, R>& y) const { return i == y.i; }
+
+    template <class C, class V, class R>
+    bool operator!=(const index_iterator<C, V, R>& y) const { return i != y.i; }
+
+    template <class C, class V, class R>
+    bool operator<(const index_iterator<C, V, R>& y) const { return i < y.i; }
+
+    template <class C, class V, class R>
+    bool operator>(const index_iterator<C, V, R>& y) const { return i > y.i; }
+
+    template <class C, class V, class R>
+    bool operator<=(const index_iterator<C, V, R>& y) const { return i <= y.i; }
+
+    template <class C, class V, class R>
+    bool operator>=(const index_iterator<C, V, R>& y) const { return i >= y.i; }
+
+    template <class, class, class> friend class index_iterator;
+};
+
+} // anonymous namespace
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "integral_constant.hpp"
+
+namespace ft {
+
+template <class T, class U>
+struct is_same : public false_type {};
+
+template <class T>
+struct is_same<T, T> : public true_type {};
+
+} // namespace ft
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "integral_constant.hpp"
+#include "remove_cv.hpp"
+
+namespace ft {
+
+template <class T>
+struct is_trivially_default_constructible
+    : public integral_constant<bool, __is_trivially_constructible(typename remove_cv<T>::type)> {};
+
+} // namespace ft
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "integral_constant.hpp"
+#include "remove_cv.hpp"
+
+namespace ft {
+
+#if defined(__clang__)
+template <class T>
+struct is_trivially_destructible
+    : public integral_constant<bool, __is_trivially_destructible(typename remove_cv<T>::type)> {};
+#else
+template <class T>
+struct is_trivially_destructible
+    : public integral_constant<bool, __has_trivial_destructor(typename remove_cv<T>::type)> {};
+#endif
+
+} // namespace ft
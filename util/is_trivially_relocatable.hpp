@@ -0,0 +1,22 @@
+#pragma once
+
+#include "integral_constant.hpp"
+#include "is_trivially_copyable.hpp"
+#include "is_trivially_destructible.hpp"
+
+namespace ft {
+
+// A type is trivially relocatable when moving an object to new storage and
+// dropping the old one without running its destructor is the same as a memcpy.
+// Types that own resources but hold no self-references (e.g. a handle with a
+// heap pointer) may opt in with:
+//
+//     namespace ft {
+//     template <> struct is_trivially_relocatable<Handle> : public true_type {};
+//     }
+template <class T>
+struct is_trivially_relocatable
+    : public integral_constant<bool, is_trivially_copyable<T>::value
+                                     && is_trivially_destructible<T>::value> {};
+
+} // namespace ft
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <cstddef>
+
+#include "enable_if.hpp"
 #include "iterator_traits.hpp"
+#include "mismatch_bytes.hpp"
+#include "wrap_iter.hpp"
 
 namespace {
 
@@ -53,7 +58,31 @@ bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
 {
     typedef typename iterator_traits<InputIterator1>::value_type v1;
     typedef typename iterator_traits<InputIterator2>::value_type v2;
-    return lexicographical_compare(first1, last1, first2, last2, less<v1, v2>());
+    return ft::lexicographical_compare(first1, last1, first2, last2, less<v1, v2>());
+}
+
+template <class T1, class T2>
+typename enable_if<is_byte_comparable<T1, T2>::value, bool>::type
+lexicographical_compare(T1* first1, T1* last1, T2* first2, T2* last2)
+{
+    std::size_t n1 = last1 - first1;
+    std::size_t n2 = last2 - first2;
+    std::size_t n = n1 < n2 ? n1 : n2;
+    std::size_t i = mismatch_bytes(reinterpret_cast<const unsigned char*>(first1),
+                                   reinterpret_cast<const unsigned char*>(first2),
+                                   n * sizeof(T1)) / sizeof(T1);
+    if (i < n) {
+        return first1[i] < first2[i];
+    }
+    return n1 < n2;
+}
+
+template <class T1, class T2>
+typename enable_if<is_byte_comparable<T1, T2>::value, bool>::type
+lexicographical_compare(wrap_iter<T1*> first1, wrap_iter<T1*> last1,
+                        wrap_iter<T2*> first2, wrap_iter<T2*> last2)
+{
+    return ft::lexicographical_compare(first1.base(), last1.base(), first2.base(), last2.base());
 }
 
 } // namespace ft
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#include "integral_constant.hpp"
+#include "is_integral.hpp"
+#include "is_same.hpp"
+#include "remove_cv.hpp"
+
+namespace {
+
+// Integers compare equal exactly when their object representations do, so
+// ranges of them can be compared as raw bytes.
+template <class T1, class T2>
+struct is_byte_comparable
+    : public ft::integral_constant<bool, ft::is_same<typename ft::remove_cv<T1>::type,
+                                                     typename ft::remove_cv<T2>::type>::value
+                                         && ft::is_integral<T1>::value> {};
+
+// Returns the index of the first byte where a and b differ, or n.
+inline std::size_t mismatch_bytes(const unsigned char* a, const unsigned char* b, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFu;
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+} // anonymous namespace
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "can_reallocate.hpp"
+#include "can_release_pages.hpp"
+#include "integral_constant.hpp"
+
+namespace ft {
+
+// Blocks of at least Threshold bytes are backed by anonymous mappings and
+// resized with mremap, so growing them remaps pages instead of copying.
+// Smaller blocks come from operator new.
+template <class T, std::size_t Threshold = 1 << 20>
+class mmap_allocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef mmap_allocator<U, Threshold> other;
+    };
+
+    mmap_allocator() {}
+
+    template <class U>
+    mmap_allocator(const mmap_allocator<U, Threshold>&) {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        size_type bytes = n * sizeof(T);
+        if (!is_mapped(bytes)) {
+            return static_cast<pointer>(::operator new(bytes));
+        }
+        void* p = ::mmap(NULL, page_round(bytes), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(p);
+    }
+
+    void deallocate(pointer p, size_type n) {
+        size_type bytes = n * sizeof(T);
+        if (is_mapped(bytes)) {
+            ::munmap(p, page_round(bytes));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+        if (new_n > max_size()) {
+            throw std::bad_alloc();
+        }
+        size_type old_bytes = old_n * sizeof(T);
+        size_type new_bytes = new_n * sizeof(T);
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        if (is_mapped(old_bytes) && is_mapped(new_bytes)) {
+            void* q = ::mremap(p, page_round(old_bytes), page_round(new_bytes), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<pointer>(q);
+        }
+#endif
+        pointer q = allocate(new_n);
+        std::memcpy(static_cast<void*>(q), static_cast<const void*>(p),
+                    (old_bytes < new_bytes ? old_bytes : new_bytes));
+        deallocate(p, old_n);
+        return q;
+    }
+
+    void release(pointer p, size_type n, size_type from) {
+        size_type bytes = n * sizeof(T);
+        if (!is_mapped(bytes)) {
+            return;
+        }
+        size_type first = page_round(from * sizeof(T));
+        size_type last = page_round(bytes);
+        if (first < last) {
+            ::madvise(reinterpret_cast<char*>(p) + first, last - first, MADV_DONTNEED);
+        }
+    }
+
+    size_type max_size() const {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference val) {
+        ::new (static_cast<void*>(p)) T(val);
+    }
+
+    void destroy(pointer p) {
+        p->~T();
+    }
+
+private:
+    static bool is_mapped(size_type bytes) {
+        return bytes >= Threshold;
+    }
+
+    static size_type page_round(size_type bytes) {
+        static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) & ~(page - 1);
+    }
+};
+
+template <class T, class U, std::size_t Threshold>
+bool operator==(const mmap_allocator<T, Threshold>&, const mmap_allocator<U, Threshold>&) {
+    return true;
+}
+
+template <class T, class U, std::size_t Threshold>
+bool operator!=(const mmap_allocator<T, Threshold>&, const mmap_allocator<U, Threshold>&) {
+    return false;
+}
+
+template <class T, std::size_t Threshold>
+struct can_reallocate<mmap_allocator<T, Threshold> > : public true_type {};
+
+template <class T, std::size_t Threshold>
+struct can_release_pages<mmap_allocator<T, Threshold> > : public true_type {};
+
+} // namespace ft
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+#if __cplusplus >= 201103L
+    #include <exception>
+#endif
+
+#include <pthread.h>
+
+namespace ft {
+
+// Opt-in request to construct a vector's elements on up to `threads` threads,
+// so that each thread first-touches its own slice of a large buffer.
+struct parallel_init {
+    explicit parallel_init(unsigned threads) : threads(threads) {}
+
+    unsigned threads;
+};
+
+// Thrown in C++98 in place of an exception other than std::bad_alloc that
+// an element's constructor threw on a worker thread, since C++98 cannot
+// carry an exception object across threads.
+class parallel_construct_error : public std::runtime_error {
+public:
+    parallel_construct_error() : std::runtime_error("ft::parallel_construct: element construction failed") {}
+};
+
+} // namespace ft
+
+namespace {
+
+const std::size_t parallel_min_bytes_per_thread = 1 << 20;
+
+template <class T>
+struct fill_source {
+    const T* val;
+
+    const T& operator[](std::size_t) const { return *val; }
+};
+
+template <class T>
+struct copy_source {
+    const T* first;
+
+    const T& operator[](std::size_t i) const { return first[i]; }
+};
+
+template <class Allocator, class Source>
+struct construct_chunk {
+    Allocator* alloc;
+    typename Allocator::pointer dest;
+    Source src;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t done;
+#if __cplusplus >= 201103L
+    std::exception_ptr error;
+#else
+    // 0 if the chunk succeeded, 1 for std::bad_alloc, 2 for anything else.
+    int error;
+#endif
+
+    void run() {
+        try {
+            for (; begin + done < end; ++done) {
+                alloc->construct(dest + begin + done, src[begin + done]);
+            }
+#if __cplusplus >= 201103L
+        } catch (...) {
+            error = std::current_exception();
+        }
+#else
+        } catch (const std::bad_alloc&) {
+            error = 1;
+        } catch (...) {
+            error = 2;
+        }
+#endif
+    }
+
+    bool failed() const {
+        return static_cast<bool>(error);
+    }
+
+    void rethrow() const {
+#if __cplusplus >= 201103L
+        std::rethrow_exception(error);
+#else
+        if (error == 1) {
+            throw std::bad_alloc();
+        }
+        throw ft::parallel_construct_error();
+#endif
+    }
+
+    void rollback() {
+        for (; done > 0; --done) {
+            alloc->destroy(dest + begin + done - 1);
+        }
+    }
+};
+
+template <class Chunk>
+void* run_construct_chunk(void* arg) {
+    static_cast<Chunk*>(arg)->run();
+    return NULL;
+}
+
+template <class Chunk>
+struct construct_worker {
+    Chunk chunk;
+    pthread_t tid;
+    bool started;
+};
+
+// Constructs dest[i] from src[i] for i in [0, n), all or nothing. The range is
+// split into one chunk per thread; if any chunk throws, every constructed
+// element is destroyed and the first failing chunk's exception is rethrown
+// (in C++98 as std::bad_alloc or ft::parallel_construct_error).
+template <class Allocator, class Source>
+void parallel_construct(Allocator& alloc, typename Allocator::pointer dest, std::size_t n,
+                        Source src, unsigned threads)
+{
+    typedef construct_chunk<Allocator, Source> chunk;
+    typedef construct_worker<chunk> worker;
+    typedef typename Allocator::value_type value_type;
+
+    std::size_t max_threads = n * sizeof(value_type) / parallel_min_bytes_per_thread;
+    std::size_t t = threads < max_threads ? threads : max_threads;
+    if (t < 2) {
+        t = 1;
+    }
+    worker* workers = new worker[t];
+    for (std::size_t i = 0; i < t; ++i) {
+        chunk& c = workers[i].chunk;
+        c.alloc = &alloc;
+        c.dest = dest;
+        c.src = src;
+        c.begin = n / t * i + (i < n % t ? i : n % t);
+        c.end = c.begin + n / t + (i < n % t ? 1 : 0);
+        c.done = 0;
+        c.error = 0;
+        workers[i].started = i > 0 && pthread_create(&workers[i].tid, NULL, run_construct_chunk<chunk>, &c) == 0;
+    }
+    const chunk* failed = NULL;
+    for (std::size_t i = 0; i < t; ++i) {
+        if (workers[i].started) {
+            pthread_join(workers[i].tid, NULL);
+        } else {
+            workers[i].chunk.run();
+        }
+        if (failed == NULL && workers[i].chunk.failed()) {
+            failed = &workers[i].chunk;
+        }
+    }
+    if (failed != NULL) {
+        for (std::size_t i = 0; i < t; ++i) {
+            workers[i].chunk.rollback();
+        }
+        try {
+            failed->rethrow();
+        } catch (...) {
+            delete[] workers;
+            throw;
+        }
+    }
+    delete[] workers;
+}
+
+} // anonymous namespace
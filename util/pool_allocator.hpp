@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "slab_pool.hpp"
+
+namespace ft {
+
+// Serves single-object allocations (the nodes of map and set) from
+// fixed-size slots in SlabBytes-byte slabs with an intrusive free list, so
+// an insert is a pointer pop instead of a malloc and nodes inserted
+// together sit together in memory. Arrays and objects larger than
+// small_object_limit or aligned beyond operator new use operator new.
+// Pooled memory is kept for reuse by the thread that freed it, passes to
+// the other threads when that thread exits, and is never returned to the
+// system; slab_pool states the bound.
+//
+// ft::pool_map<K, V>::type and ft::pool_set<K>::type name a map and a set
+// that use it; the tree rebinds it to its node type.
+template <class T, std::size_t SlabBytes = 64 * 1024>
+class pool_allocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef pool_allocator<U, SlabBytes> other;
+    };
+
+    static const size_type small_object_limit = 256;
+
+    pool_allocator() {}
+
+    template <class U>
+    pool_allocator(const pool_allocator<U, SlabBytes>&) {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        if (n == 1 && pooled) {
+            return static_cast<pointer>(pool::allocate());
+        }
+        return static_cast<pointer>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(pointer p, size_type n) {
+        if (n == 1 && pooled) {
+            pool::deallocate(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    size_type max_size() const {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference val) {
+        ::new (static_cast<void*>(p)) T(val);
+    }
+
+    void destroy(pointer p) {
+        p->~T();
+    }
+
+private:
+    static const size_type slot_align = __alignof__(T) > sizeof(void*) ? __alignof__(T) : sizeof(void*);
+    static const size_type slot_size = (sizeof(T) + slot_align - 1) / slot_align * slot_align;
+    static const bool pooled = slot_size <= small_object_limit && slot_align <= 16 && slot_size <= SlabBytes;
+
+    typedef slab_pool<slot_size, heap_slabs<SlabBytes> > pool;
+};
+
+template <class T, class U, std::size_t SlabBytes>
+bool operator==(const pool_allocator<T, SlabBytes>&, const pool_allocator<U, SlabBytes>&) {
+    return true;
+}
+
+template <class T, class U, std::size_t SlabBytes>
+bool operator!=(const pool_allocator<T, SlabBytes>&, const pool_allocator<U, SlabBytes>&) {
+    return false;
+}
+
+} // namespace ft
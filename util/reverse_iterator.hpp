@@ -1,18 +1,11 @@
 #pragma once
 
-#include <iterator>
-
 #include "iterator_traits.hpp"
 
 namespace ft {
 
 template <class Iter>
-class reverse_iterator
-    : public std::iterator<typename iterator_traits<Iter>::iterator_category,
-                           typename iterator_traits<Iter>::value_type,
-                           typename iterator_traits<Iter>::difference_type,
-                           typename iterator_traits<Iter>::pointer,
-                           typename iterator_traits<Iter>::reference> {
+class reverse_iterator {
 protected:
     Iter current;
 
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <pthread.h>
+
+#include "atomic.hpp"
+
+namespace {
+
+// Per-thread pool of Size-byte slots carved out of slabs of
+// Slabs::slab_size bytes from Slabs::allocate(). Consecutive allocations
+// on a thread get adjacent slots. A freed slot goes on an intrusive list
+// of the freeing thread and is handed out again first.
+//
+// When a thread exits, its free slots and the unused rest of its current
+// slab move to a shared list, which a thread adopts whole before it takes
+// a new slab. Slabs are never returned to Slabs, so the pool holds at most
+// the peak number of slots live at once, plus the slots on the free lists
+// of running threads, plus the rest of one slab per running thread.
+template <std::size_t Size, class Slabs>
+struct slab_pool {
+    struct free_slot {
+        free_slot* next;
+    };
+
+    struct state {
+        free_slot* free;
+        char* cur;
+        char* end;
+        bool exit_hooked;
+    };
+
+    static __thread state local;
+    static free_slot* orphans;
+    static pthread_mutex_t orphans_lock;
+    static pthread_once_t key_once;
+    static pthread_key_t exit_key;
+
+    static void* allocate() {
+        state& s = local;
+        if (s.free != NULL) {
+            free_slot* f = s.free;
+            s.free = f->next;
+            return f;
+        }
+        if (static_cast<std::size_t>(s.end - s.cur) < Size) {
+            if (!s.exit_hooked) {
+                pthread_once(&key_once, create_exit_key);
+                pthread_setspecific(exit_key, &s);
+                s.exit_hooked = true;
+            }
+            if (adopt_orphans(s)) {
+                return allocate();
+            }
+            s.cur = static_cast<char*>(Slabs::allocate());
+            s.end = s.cur + Slabs::slab_size;
+        }
+        void* p = s.cur;
+        s.cur += Size;
+        return p;
+    }
+
+    static void deallocate(void* p) {
+        free_slot* f = static_cast<free_slot*>(p);
+        f->next = local.free;
+        local.free = f;
+    }
+
+    static bool adopt_orphans(state& s) {
+        if (atomic_load_relaxed(&orphans) == NULL) {
+            return false;
+        }
+        pthread_mutex_lock(&orphans_lock);
+        s.free = orphans;
+        atomic_store_relaxed(&orphans, static_cast<free_slot*>(NULL));
+        pthread_mutex_unlock(&orphans_lock);
+        return s.free != NULL;
+    }
+
+    static void create_exit_key() {
+        pthread_key_create(&exit_key, hand_off);
+    }
+
+    // Runs at thread exit with the thread's state.
+    static void hand_off(void* arg) {
+        state& s = *static_cast<state*>(arg);
+        s.exit_hooked = false;
+        for (; static_cast<std::size_t>(s.end - s.cur) >= Size; s.cur += Size) {
+            free_slot* f = reinterpret_cast<free_slot*>(s.cur);
+            f->next = s.free;
+            s.free = f;
+        }
+        s.cur = s.end = NULL;
+        if (s.free == NULL) {
+            return;
+        }
+        free_slot* last = s.free;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        pthread_mutex_lock(&orphans_lock);
+        last->next = orphans;
+        atomic_store_relaxed(&orphans, s.free);
+        pthread_mutex_unlock(&orphans_lock);
+        s.free = NULL;
+    }
+};
+
+template <std::size_t Size, class Slabs>
+__thread typename slab_pool<Size, Slabs>::state slab_pool<Size, Slabs>::local = { NULL, NULL, NULL, false };
+
+template <std::size_t Size, class Slabs>
+typename slab_pool<Size, Slabs>::free_slot* slab_pool<Size, Slabs>::orphans = NULL;
+
+template <std::size_t Size, class Slabs>
+pthread_mutex_t slab_pool<Size, Slabs>::orphans_lock = PTHREAD_MUTEX_INITIALIZER;
+
+template <std::size_t Size, class Slabs>
+pthread_once_t slab_pool<Size, Slabs>::key_once = PTHREAD_ONCE_INIT;
+
+template <std::size_t Size, class Slabs>
+pthread_key_t slab_pool<Size, Slabs>::exit_key;
+
+// Slabs of Bytes bytes from operator new, aligned for any fundamental type.
+template <std::size_t Bytes>
+struct heap_slabs {
+    static const std::size_t slab_size = Bytes;
+
+    static void* allocate() {
+        return ::operator new(Bytes);
+    }
+};
+
+} // anonymous namespace
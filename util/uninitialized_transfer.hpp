@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+
+#if __cplusplus >= 201103L
+    #include <type_traits>
+#endif
+
+#include "integral_constant.hpp"
+
+namespace ft {
+
+#if __cplusplus >= 201103L
+template <class Pointer>
+Pointer uninitialized_transfer(Pointer first, Pointer last, Pointer dest, true_type) {
+    return std::uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+}
+
+template <class Pointer>
+Pointer uninitialized_transfer(Pointer first, Pointer last, Pointer dest, false_type) {
+    return std::uninitialized_copy(first, last, dest);
+}
+
+// Constructs [first, last) into the raw memory at dest for a relocation.
+// Elements are moved when that cannot throw (or when they cannot be
+// copied), and copied otherwise so that a throwing copy leaves the source
+// intact. On a throw the elements already built at dest are destroyed.
+template <class Pointer>
+Pointer uninitialized_transfer(Pointer first, Pointer last, Pointer dest) {
+    typedef typename std::iterator_traits<Pointer>::value_type value_type;
+    return uninitialized_transfer(first, last, dest,
+                                  integral_constant<bool, std::is_nothrow_move_constructible<value_type>::value
+                                                          || !std::is_copy_constructible<value_type>::value>());
+}
+#else
+template <class Pointer>
+Pointer uninitialized_transfer(Pointer first, Pointer last, Pointer dest) {
+    return std::uninitialized_copy(first, last, dest);
+}
+#endif
+
+} // namespace ft
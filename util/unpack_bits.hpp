@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+// Decodes values of width bits packed little-endian from bit first_bit of
+// bytes: out[i] = base + (the width bits at first_bit + i * width), modulo
+// 2^32. Decodes whole groups of eight and returns how many it wrote, leaving
+// the rest to the caller; 0 when no SIMD kernel applies. Each value is read
+// as four bytes, so width must be at most 25 and bytes must stay readable
+// three bytes past the last packed bit.
+inline std::size_t unpack_bits32(const unsigned char* bytes, std::size_t first_bit, unsigned width,
+                                 std::size_t n, unsigned base, unsigned* out) {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if (width > 0 && width <= 25) {
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i mask = _mm256_set1_epi32(static_cast<int>((1u << width) - 1));
+        const __m256i vbase = _mm256_set1_epi32(static_cast<int>(base));
+        const __m256i seven = _mm256_set1_epi32(7);
+        for (; i + 8 <= n; i += 8) {
+            // Bit offsets relative to the first value of the group, which is
+            // at most 7 * 25 + 7 bits in and so fits an int easily.
+            std::size_t bit = first_bit + i * width;
+            const unsigned char* group = bytes + bit / 8;
+            __m256i rel = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(bit % 8)),
+                                           _mm256_mullo_epi32(lane, _mm256_set1_epi32(static_cast<int>(width))));
+            __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(group), _mm256_srli_epi32(rel, 3), 1);
+            v = _mm256_and_si256(_mm256_srlv_epi32(v, _mm256_and_si256(rel, seven)), mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(v, vbase));
+        }
+    }
+#else
+    (void)bytes;
+    (void)first_bit;
+    (void)width;
+    (void)n;
+    (void)base;
+    (void)out;
+#endif
+    return i;
+}
+
+} // anonymous namespace
@@ -2,18 +2,42 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 
-#include "algorithm.hpp"
-#include "iterator.hpp"
-#include "type_traits.hpp"
+#if __cplusplus >= 201103L
+    #include <type_traits>
+#endif
+
+#include "util/bit_reference.hpp"
+#include "util/can_reallocate.hpp"
+#include "util/can_release_pages.hpp"
+#include "util/default_init.hpp"
+#include "util/enable_if.hpp"
+#include "util/equal.hpp"
+#include "util/growth_policy.hpp"
+#include "util/integral_constant.hpp"
+#include "util/is_integral.hpp"
+#include "util/is_trivially_copyable.hpp"
+#include "util/is_trivially_default_constructible.hpp"
+#include "util/is_trivially_destructible.hpp"
+#include "util/is_trivially_relocatable.hpp"
+#include "util/iterator_traits.hpp"
+#include "util/lexicographical_compare.hpp"
+#include "util/parallel_construct.hpp"
+#include "util/reverse_iterator.hpp"
+#include "util/uninitialized_transfer.hpp"
+#include "util/wrap_iter.hpp"
 
 namespace ft {
 
+    template <class Vector>
+    class batch_back_insert_iterator;
+
     template <class T, class Allocator = std::allocator<T> >
     class vector {
     public:
@@ -30,7 +54,7 @@ namespace ft {
         typedef ft::reverse_iterator<iterator> reverse_iterator;
         typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    private:
+    protected:
         allocator_type alloc_;
         pointer begin_;
         pointer end_;
@@ -57,6 +81,24 @@ namespace ft {
             }
         }
 
+        vector(size_type n, const value_type& val, parallel_init p,
+               const allocator_type& alloc = allocator_type())
+            : alloc_(alloc)
+            , begin_(NULL)
+            , end_(NULL)
+            , end_cap_(NULL)
+        {
+            if (n > 0) {
+                vallocate(n);
+                try {
+                    construct_at_end(n, val, p);
+                } catch (...) {
+                    vdeallocate();
+                    throw;
+                }
+            }
+        }
+
         template <class InputIterator>
         vector(InputIterator first, InputIterator last,
                const allocator_type& alloc = allocator_type(),
@@ -66,8 +108,11 @@ namespace ft {
             , end_(NULL)
             , end_cap_(NULL)
         {
-            for (; first != last; ++first) {
-                push_back(*first);
+            try {
+                init_range(first, last, typename iterator_traits<InputIterator>::iterator_category());
+            } catch (...) {
+                vdeallocate();
+                throw;
             }
         }
 
@@ -84,15 +129,54 @@ namespace ft {
             }
         }
 
+        vector(const vector& x, parallel_init p)
+            : alloc_(x.alloc_)
+            , begin_(NULL)
+            , end_(NULL)
+            , end_cap_(NULL)
+        {
+            size_type n = x.size();
+            if (n > 0) {
+                vallocate(n);
+                try {
+                    construct_at_end(x.begin_, x.end_, p);
+                } catch (...) {
+                    vdeallocate();
+                    throw;
+                }
+            }
+        }
+
         vector& operator=(const vector& x) {
             if (this != &x) {
-                vdeallocate();
-                begin_ = end_ = end_cap_ = NULL;
                 assign(x.begin_, x.end_);
             }
             return *this;
         }
 
+#if __cplusplus >= 201103L
+        vector(vector&& x) noexcept
+            : alloc_(std::move(x.alloc_))
+            , begin_(x.begin_)
+            , end_(x.end_)
+            , end_cap_(x.end_cap_)
+        {
+            x.begin_ = x.end_ = x.end_cap_ = NULL;
+        }
+
+        vector& operator=(vector&& x) noexcept {
+            if (this != &x) {
+                vdeallocate();
+                alloc_ = std::move(x.alloc_);
+                begin_ = x.begin_;
+                end_ = x.end_;
+                end_cap_ = x.end_cap_;
+                x.begin_ = x.end_ = x.end_cap_ = NULL;
+            }
+            return *this;
+        }
+#endif
+
         ~vector() {
             vdeallocate();
         }
@@ -116,19 +200,28 @@ namespace ft {
             if (n <= capacity()) {
                 return;
             }
-            pointer new_begin = alloc_.allocate(n);
-            pointer new_end = new_begin + size();
-            pointer new_end_cap = new_begin + n;
-            try {
-                std::uninitialized_copy(begin_, end_, new_begin);
-            } catch (...) {
-                alloc_.deallocate(new_begin, n);
-                throw;
+            vreallocate(n, reallocates_in_place());
+        }
+
+        void shrink_to_fit() {
+            if (capacity() > size()) {
+                try {
+                    if (empty()) {
+                        vdeallocate();
+                    } else {
+                        vreallocate(size(), reallocates_in_place());
+                    }
+                } catch (...) {
+                }
+            }
+        }
+
+        // Hands the pages behind the unused capacity back to the OS if the
+        // allocator can do so. Elements and capacity() are left as they are.
+        void release_unused() {
+            if (begin_ != NULL) {
+                release_unused(can_release_pages<allocator_type>());
             }
-            vdeallocate();
-            begin_ = new_begin;
-            end_ = new_end;
-            end_cap_ = new_end_cap;
         }
 
         void resize(size_type n, value_type val = value_type()) {
@@ -143,6 +236,32 @@ namespace ft {
             }
         }
 
+        void resize(size_type n, default_init_t) {
+            size_type sz = size();
+            if (sz < n) {
+                if (n > capacity()) {
+                    reserve(n);
+                }
+                default_construct_at_end(n - sz, is_trivially_default_constructible<value_type>());
+            } else if (sz > n) {
+                destruct_at_end(begin_ + n);
+            }
+        }
+
+        // Grows the vector by n uninitialized elements and returns a pointer
+        // to the first of them, e.g. to read() or decode straight into it.
+        // Only available for trivially default constructible types.
+        pointer append_uninitialized(size_type n) {
+            typedef char trivially_default_constructible_only[is_trivially_default_constructible<value_type>::value ? 1 : -1]
+                __attribute__((__unused__));
+            if (n > static_cast<size_type>(end_cap_ - end_)) {
+                reserve(recommend(size() + n));
+            }
+            pointer p = end_;
+            end_ += n;
+            return p;
+        }
+
         reference operator[](size_type n) { return begin_[n]; }
         const_reference operator[](size_type n) const { return begin_[n]; }
 
@@ -168,9 +287,7 @@ namespace ft {
         template <class InputIterator>
         typename enable_if<!is_integral<InputIterator>::value, void>::type
         assign(InputIterator first, InputIterator last) {
-            clear();
-            for (; first != last; ++first)
-                push_back(*first);
+            assign_range(first, last, typename iterator_traits<InputIterator>::iterator_category());
         }
 
         void assign(size_type n, const value_type& val) {
@@ -189,13 +306,66 @@ namespace ft {
             }
         }
 
+        void assign(size_type n, const value_type& val, parallel_init p) {
+            if (n <= capacity()) {
+                assign(n, val);
+            } else {
+                vdeallocate();
+                vallocate(n);
+                construct_at_end(n, val, p);
+            }
+        }
+
         void push_back(const value_type& val) {
             if (end_ == end_cap_) {
-                reserve(capacity() ? capacity() * 2 : 1);
+                reserve(recommend(size() + 1));
             }
             construct_at_end(1, val);
         }
 
+#if __cplusplus >= 201103L
+        void push_back(value_type&& val) {
+            emplace_back(std::move(val));
+        }
+
+        template <class... Args>
+        void emplace_back(Args&&... args) {
+            if (end_ != end_cap_) {
+                construct_one(end_, std::forward<Args>(args)...);
+                ++end_;
+            } else if (reallocates_in_place::value) {
+                value_type tmp(std::forward<Args>(args)...);
+                reserve(recommend(size() + 1));
+                construct_one(end_, std::move(tmp));
+                ++end_;
+            } else {
+                size_type n = recommend(size() + 1);
+                pointer new_begin = alloc_.allocate(n);
+                try {
+                    construct_one(new_begin + size(), std::forward<Args>(args)...);
+                } catch (...) {
+                    alloc_.deallocate(new_begin, n);
+                    throw;
+                }
+                swap_out_buffer(new_begin, n, end_, 1);
+            }
+        }
+#endif
+
+        template <class InputIterator>
+        typename enable_if<!is_integral<InputIterator>::value, void>::type
+        append(InputIterator first, InputIterator last) {
+            append_range(first, last, typename iterator_traits<InputIterator>::iterator_category());
+        }
+
+        void append_n(size_type n, const value_type& val) {
+            if (n <= static_cast<size_type>(end_cap_ - end_)) {
+                construct_at_end(n, val);
+            } else {
+                insert(end(), n, val);
+            }
+        }
+
         void pop_back() {
             destruct_at_end(end_ - 1);
         }
@@ -207,32 +377,61 @@ namespace ft {
                 if (p == end_) {
                     construct_at_end(1, val);
                 } else {
-                    std::copy_backward(p, end_, end_ + 1);
-                    *p = val;
-                    ++end_;
+                    const_pointer xr = &val;
+                    move_range(p, end_, p + 1);
+                    if (p <= xr && xr < end_) {
+                        ++xr;
+                    }
+                    *p = *xr;
                 }
             } else {
-                size_type n = capacity() ? capacity() * 2 : 1;
+                size_type n = recommend(size() + 1);
                 pointer new_begin = alloc_.allocate(n);
-                pointer new_end = new_begin + size() + 1;
-                pointer new_end_cap = new_begin + n;
                 try {
-                    std::uninitialized_copy(begin_, p, new_begin);
                     alloc_.construct(new_begin + d, val);
-                    std::uninitialized_copy(p, end_, new_begin + d + 1);
                 } catch (...) {
-                    alloc_.destroy(new_begin + d);
                     alloc_.deallocate(new_begin, n);
                     throw;
                 }
-                vdeallocate();
-                begin_ = new_begin;
-                end_ = new_end;
-                end_cap_ = new_end_cap;
+                swap_out_buffer(new_begin, n, p, 1);
+                p = begin_ + d;
             }
             return p;
         }
 
+#if __cplusplus >= 201103L
+        iterator insert(iterator position, value_type&& val) {
+            return emplace(position, std::move(val));
+        }
+
+        template <class... Args>
+        iterator emplace(iterator position, Args&&... args) {
+            difference_type d = position - begin();
+            pointer p = begin_ + d;
+            value_type tmp(std::forward<Args>(args)...);
+            if (end_ != end_cap_) {
+                if (p == end_) {
+                    construct_one(end_, std::move(tmp));
+                    ++end_;
+                } else {
+                    move_range(p, end_, p + 1);
+                    *p = std::move(tmp);
+                }
+            } else {
+                size_type n = recommend(size() + 1);
+                pointer new_begin = alloc_.allocate(n);
+                try {
+                    construct_one(new_begin + d, std::move(tmp));
+                } catch (...) {
+                    alloc_.deallocate(new_begin, n);
+                    throw;
+                }
+                swap_out_buffer(new_begin, n, p, 1);
+            }
+            return begin() + d;
+        }
+#endif
+
         void insert(iterator position, size_type n, const value_type& val) {
             if (n == 0) {
                 return;
@@ -240,6 +439,7 @@ namespace ft {
             difference_type d = position - begin();
             pointer p = begin_ + d;
             if (n <= static_cast<size_type>(end_cap_ - end_)) {
+                size_type old_n = n;
                 pointer old_end = end_;
                 if (n > static_cast<size_type>(end_ - p)) {
                     size_type c = n - (end_ - p);
@@ -247,78 +447,46 @@ namespace ft {
                     n -= c;
                 }
                 if (n > 0) {
-                    std::copy_backward(p, old_end, old_end + n);
-                    std::fill_n(p, n, val);
+                    const_pointer xr = &val;
+                    move_range(p, old_end, p + old_n);
+                    if (p <= xr && xr < end_) {
+                        xr += old_n;
+                    }
+                    std::fill_n(p, n, *xr);
                 }
             } else {
-                size_type new_cap = std::max(capacity() * 2, size() + n);
+                size_type new_cap = recommend(size() + n);
                 pointer new_begin = alloc_.allocate(new_cap);
-                pointer new_end = new_begin + size() + n;
-                pointer new_end_cap = new_begin + new_cap;
+                size_type i = 0;
                 try {
-                    std::uninitialized_copy(begin_, p, new_begin);
-                    for (size_type i = 0; i < n; ++i) {
+                    for (; i < n; ++i) {
                         alloc_.construct(new_begin + d + i, val);
                     }
-                    std::uninitialized_copy(p, end_, new_begin + d + n);
                 } catch (...) {
-                    for (size_type i = 0; i < n; ++i) {
-                        alloc_.destroy(new_begin + d + i);
-                    }
-                    alloc_.deallocate(new_begin, n);
+                    destroy_range(new_begin + d, new_begin + d + i);
+                    alloc_.deallocate(new_begin, new_cap);
                     throw;
                 }
-                vdeallocate();
-                begin_ = new_begin;
-                end_ = new_end;
-                end_cap_ = new_end_cap;
+                swap_out_buffer(new_begin, new_cap, p, n);
             }
         }
 
         template <class InputIterator>
         typename enable_if<!is_integral<InputIterator>::value, void>::type
         insert(iterator position, InputIterator first, InputIterator last) {
-            if (first == last) {
-                return;
-            }
-            difference_type d = position - begin();
-            pointer p = begin_ + d;
-            vector<T> tmp(first, last);
-            size_type n = tmp.size();
-            if (n <= static_cast<size_type>(end_cap_ - end_)) {
-                std::copy_backward(p, end_, end_ + n);
-                std::copy(tmp.begin_, tmp.end_, p);
-                end_ += n;
-            } else {
-                size_type new_cap = std::max(capacity() * 2, size() + n);
-                pointer new_begin = alloc_.allocate(new_cap);
-                pointer new_end = new_begin + size() + n;
-                pointer new_end_cap = new_begin + new_cap;
-                try {
-                    std::uninitialized_copy(begin_, p, new_begin);
-                    std::uninitialized_copy(tmp.begin_, tmp.end_, new_begin + d);
-                    std::uninitialized_copy(p, end_, new_begin + d + n);
-                } catch (...) {
-                    alloc_.deallocate(new_begin, n);
-                    throw;
-                }
-                vdeallocate();
-                begin_ = new_begin;
-                end_ = new_end;
-                end_cap_ = new_end_cap;
-            }
+            insert_range(position, first, last, typename iterator_traits<InputIterator>::iterator_category());
         }
 
         iterator erase(iterator position) {
             pointer p = begin_ + (position - begin());
-            destruct_at_end(std::copy(p + 1, end_, p));
+            destruct_at_end(move_left(p + 1, end_, p));
             return p;
         }
 
         iterator erase(iterator first, iterator last) {
             pointer p = begin_ + (first - begin());
             if (first != last) {
-                destruct_at_end(std::copy(p + (last - first), end_, p));
+                destruct_at_end(move_left(p + (last - first), end_, p));
             }
             return p;
         }
@@ -339,54 +507,377 @@ namespace ft {
             return alloc_;
         }
 
-    private:
+    protected:
+        template <class Vector>
+        friend class batch_back_insert_iterator;
+
+        typedef integral_constant<bool, can_reallocate<allocator_type>::value
+                                        && is_trivially_relocatable<value_type>::value> reallocates_in_place;
+
+        template <class InputIterator>
+        void init_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        template <class ForwardIterator>
+        void init_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            if (n > 0) {
+                vallocate(n);
+                construct_at_end(first, last);
+            }
+        }
+
+        template <class InputIterator>
+        void assign_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+            clear();
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        template <class ForwardIterator>
+        void assign_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            if (n <= capacity()) {
+                ForwardIterator mid = last;
+                bool growing = n > size();
+                if (growing) {
+                    mid = first;
+                    std::advance(mid, size());
+                }
+                pointer m = std::copy(first, mid, begin_);
+                if (growing) {
+                    construct_at_end(mid, last);
+                } else {
+                    destruct_at_end(m);
+                }
+            } else {
+                vdeallocate();
+                vallocate(n);
+                construct_at_end(first, last);
+            }
+        }
+
+        template <class InputIterator>
+        void append_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        template <class ForwardIterator>
+        void append_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            insert_range(end(), first, last, std::forward_iterator_tag());
+        }
+
+        template <class InputIterator>
+        void insert_range(iterator position, InputIterator first, InputIterator last, std::input_iterator_tag) {
+            vector tmp(first, last, alloc_);
+            insert_range(position, tmp.begin_, tmp.end_, std::random_access_iterator_tag());
+        }
+
+        template <class ForwardIterator>
+        void insert_range(iterator position, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            if (first == last) {
+                return;
+            }
+            difference_type d = position - begin();
+            pointer p = begin_ + d;
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            if (n <= static_cast<size_type>(end_cap_ - end_)) {
+                pointer old_end = end_;
+                ForwardIterator mid = last;
+                difference_type dx = end_ - p;
+                if (n > static_cast<size_type>(dx)) {
+                    mid = first;
+                    std::advance(mid, dx);
+                    construct_at_end(mid, last);
+                }
+                if (dx > 0) {
+                    move_range(p, old_end, p + n);
+                    std::copy(first, mid, p);
+                }
+            } else {
+                size_type new_cap = recommend(size() + n);
+                pointer new_begin = alloc_.allocate(new_cap);
+                try {
+                    std::uninitialized_copy(first, last, new_begin + d);
+                } catch (...) {
+                    alloc_.deallocate(new_begin, new_cap);
+                    throw;
+                }
+                swap_out_buffer(new_begin, new_cap, p, n);
+            }
+        }
+
+        size_type recommend(size_type n) const {
+            size_type ms = max_size();
+            if (n > ms) {
+                throw std::length_error("vector");
+            }
+            return vector_growth<value_type, allocator_type>::template recommend<value_type>(capacity(), n, ms);
+        }
+
         void vallocate(size_type n) {
             begin_ = end_ = alloc_.allocate(n);
             end_cap_ = begin_ + n;
         }
 
+        void release_unused(true_type) {
+            alloc_.release(begin_, capacity(), size());
+        }
+
+        void release_unused(false_type) {}
+
+        void vreallocate(size_type n, true_type) {
+            size_type sz = size();
+            begin_ = begin_ != NULL ? alloc_.reallocate(begin_, capacity(), n) : alloc_.allocate(n);
+            end_ = begin_ + sz;
+            end_cap_ = begin_ + n;
+        }
+
+        void vreallocate(size_type n, false_type) {
+            swap_out_buffer(alloc_.allocate(n), n, end_, 0);
+        }
+
         void vdeallocate() {
             if (begin_ != NULL) {
                 clear();
                 alloc_.deallocate(begin_, capacity());
+                begin_ = end_ = end_cap_ = NULL;
             }
         }
 
         void construct_at_end(size_type n, const value_type& val) {
-            while (n--) {
-                alloc_.construct(end_++, val);
+            for (; n > 0; --n) {
+                alloc_.construct(end_, val);
+                ++end_;
+            }
+        }
+
+        void construct_at_end(size_type n, const value_type& val, parallel_init p) {
+            fill_source<value_type> src = { &val };
+            parallel_construct(alloc_, end_, n, src, p.threads);
+            end_ += n;
+        }
+
+        void construct_at_end(const_pointer first, const_pointer last, parallel_init p) {
+            copy_source<value_type> src = { first };
+            parallel_construct(alloc_, end_, last - first, src, p.threads);
+            end_ += last - first;
+        }
+
+        void default_construct_at_end(size_type n, true_type) {
+            end_ += n;
+        }
+
+        void default_construct_at_end(size_type n, false_type) {
+            for (; n > 0; --n) {
+                ::new (static_cast<void*>(end_)) value_type;
+                ++end_;
             }
         }
 
         template <class InputIterator>
         typename enable_if<!is_integral<InputIterator>::value, void>::type
         construct_at_end(InputIterator first, InputIterator last) {
-            while (first != last) {
-                alloc_.construct(end_++, *first++);
+            for (; first != last; ++first) {
+                alloc_.construct(end_, *first);
+                ++end_;
             }
         }
 
         void destruct_at_end(pointer new_end) {
+            destruct_at_end(new_end, is_trivially_destructible<value_type>());
+        }
+
+        void destruct_at_end(pointer new_end, true_type) {
+            end_ = new_end;
+        }
+
+        void destruct_at_end(pointer new_end, false_type) {
             while (end_ != new_end) {
                 alloc_.destroy(--end_);
             }
         }
-    };
 
-    template <class T, class Allocator>
-    inline bool operator==(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
-        return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
-    }
+        void destroy_range(pointer first, pointer last) {
+            if (!is_trivially_destructible<value_type>::value) {
+                for (; first != last; ++first) {
+                    alloc_.destroy(first);
+                }
+            }
+        }
 
-    template <class T, class Allocator>
-    inline bool operator!=(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
-        return !(x == y);
-    }
+        // Shifts [from_s, from_e) right to start at to, constructing the
+        // elements that land past end_.
+        void move_range(pointer from_s, pointer from_e, pointer to) {
+            move_range(from_s, from_e, to, is_trivially_copyable<value_type>());
+        }
 
-    template <class T, class Allocator>
-    inline bool operator<(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
-        return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
-    }
+        void move_range(pointer from_s, pointer from_e, pointer to, true_type) {
+            std::memmove(static_cast<void*>(to), static_cast<const void*>(from_s),
+                         (from_e - from_s) * sizeof(value_type));
+            end_ = to + (from_e - from_s);
+        }
+
+        void move_range(pointer from_s, pointer from_e, pointer to, false_type) {
+            pointer old_end = end_;
+            difference_type n = old_end - to;
+#if __cplusplus >= 201103L
+            for (pointer i = from_s + n; i < from_e; ++i) {
+                construct_one(end_, std::move(*i));
+                ++end_;
+            }
+            std::move_backward(from_s, from_s + n, old_end);
+#else
+            for (pointer i = from_s + n; i < from_e; ++i) {
+                alloc_.construct(end_, *i);
+                ++end_;
+            }
+            std::copy_backward(from_s, from_s + n, old_end);
+#endif
+        }
+
+        pointer move_left(pointer first, pointer last, pointer dest) {
+            return move_left(first, last, dest, is_trivially_copyable<value_type>());
+        }
+
+        pointer move_left(pointer first, pointer last, pointer dest, true_type) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                         (last - first) * sizeof(value_type));
+            return dest + (last - first);
+        }
+
+        pointer move_left(pointer first, pointer last, pointer dest, false_type) {
+#if __cplusplus >= 201103L
+            return std::move(first, last, dest);
+#else
+            return std::copy(first, last, dest);
+#endif
+        }
+
+#if __cplusplus >= 201103L
+        template <class... Args>
+        void construct_one(pointer p, Args&&... args) {
+            ::new (static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+        }
+#endif
+
+        // Moves the elements into new_begin, leaving the n already constructed
+        // elements at the offset of p in between, and adopts the new block.
+        // On failure the new block is released and *this is left untouched.
+        void swap_out_buffer(pointer new_begin, size_type new_cap, pointer p, size_type n) {
+            pointer new_end = new_begin + size() + n;
+            swap_out_buffer(new_begin, new_cap, p, n, is_trivially_relocatable<value_type>());
+            begin_ = new_begin;
+            end_ = new_end;
+            end_cap_ = new_begin + new_cap;
+        }
+
+        void swap_out_buffer(pointer new_begin, size_type, pointer p, size_type n, true_type) {
+            if (begin_ != NULL) {
+                pointer mid = new_begin + (p - begin_);
+                std::memcpy(static_cast<void*>(new_begin), static_cast<const void*>(begin_),
+                            (p - begin_) * sizeof(value_type));
+                std::memcpy(static_cast<void*>(mid + n), static_cast<const void*>(p),
+                            (end_ - p) * sizeof(value_type));
+                alloc_.deallocate(begin_, capacity());
+            }
+        }
+
+        void swap_out_buffer(pointer new_begin, size_type new_cap, pointer p, size_type n, false_type) {
+            pointer mid = new_begin + (p - begin_);
+            pointer cur = new_begin;
+            try {
+                cur = uninitialized_transfer(begin_, p, new_begin);
+                uninitialized_transfer(p, end_, mid + n);
+            } catch (...) {
+                destroy_range(new_begin, cur);
+                destroy_range(mid, mid + n);
+                alloc_.deallocate(new_begin, new_cap);
+                throw;
+            }
+            vdeallocate();
+        }
+    };
+
+    // Output iterator that appends to a vector in blocks: it makes room for
+    // `batch` more elements whenever the vector is full and then constructs
+    // each element straight into the spare capacity.
+    template <class Vector>
+    class batch_back_insert_iterator {
+    public:
+        typedef Vector container_type;
+        typedef typename Vector::value_type value_type;
+        typedef typename Vector::size_type size_type;
+        typedef std::output_iterator_tag iterator_category;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+    private:
+        Vector* c;
+        size_type batch;
+
+    public:
+        batch_back_insert_iterator(Vector& x, size_type n)
+            : c(&x)
+            , batch(n > 0 ? n : 1)
+        {
+            c->reserve(c->size() + batch);
+        }
+
+        batch_back_insert_iterator& operator=(const value_type& v) {
+            make_room();
+            c->construct_at_end(1, v);
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        batch_back_insert_iterator& operator=(value_type&& v) {
+            make_room();
+            c->construct_one(c->end_, std::move(v));
+            ++c->end_;
+            return *this;
+        }
+#endif
+
+        batch_back_insert_iterator& operator*() { return *this; }
+        batch_back_insert_iterator& operator++() { return *this; }
+        batch_back_insert_iterator& operator++(int) { return *this; }
+
+    private:
+        void make_room() {
+            if (c->end_ == c->end_cap_) {
+                c->reserve(c->recommend(c->size() + batch));
+            }
+        }
+    };
+
+    template <class T, class Allocator>
+    inline batch_back_insert_iterator<vector<T, Allocator> >
+    batch_back_inserter(vector<T, Allocator>& x, typename vector<T, Allocator>::size_type batch) {
+        return batch_back_insert_iterator<vector<T, Allocator> >(x, batch);
+    }
+
+    template <class T, class Allocator>
+    inline bool operator==(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
+        return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+    }
+
+    template <class T, class Allocator>
+    inline bool operator!=(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
+        return !(x == y);
+    }
+
+    template <class T, class Allocator>
+    inline bool operator<(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
+        return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
 
     template <class T, class Allocator>
     inline bool operator>(const vector<T, Allocator>& x, const vector<T, Allocator>& y) {
@@ -408,4 +899,459 @@ namespace ft {
         x.swap(y);
     }
 
+    // Packs the bools one per bit into words. Bits past size() in the last word
+    // are kept clear, so the whole-word operations need no tail handling.
+    template <class Allocator>
+    class vector<bool, Allocator> {
+    public:
+        typedef bool value_type;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef unsigned long word_type;
+        typedef bit_reference<word_type> reference;
+        typedef bool const_reference;
+        typedef bit_iterator<word_type, false> iterator;
+        typedef bit_iterator<word_type, true> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static const size_type bits_per_word = sizeof(word_type) * 8;
+
+    protected:
+        typedef typename allocator_type::template rebind<word_type>::other word_allocator;
+
+        allocator_type alloc_;
+        word_allocator walloc_;
+        word_type* begin_;
+        size_type size_;
+        size_type cap_;
+
+    public:
+        explicit vector(const allocator_type& alloc = allocator_type())
+            : alloc_(alloc)
+            , walloc_(alloc)
+            , begin_(NULL)
+            , size_(0)
+            , cap_(0)
+        {}
+
+        explicit vector(size_type n, const value_type& val = value_type(),
+                        const allocator_type& alloc = allocator_type())
+            : alloc_(alloc)
+            , walloc_(alloc)
+            , begin_(NULL)
+            , size_(0)
+            , cap_(0)
+        {
+            resize(n, val);
+        }
+
+        template <class InputIterator>
+        vector(InputIterator first, InputIterator last,
+               const allocator_type& alloc = allocator_type(),
+               typename enable_if<!is_integral<InputIterator>::value>::type* = NULL)
+            : alloc_(alloc)
+            , walloc_(alloc)
+            , begin_(NULL)
+            , size_(0)
+            , cap_(0)
+        {
+            try {
+                insert(end(), first, last);
+            } catch (...) {
+                vdeallocate();
+                throw;
+            }
+        }
+
+        vector(const vector& x)
+            : alloc_(x.alloc_)
+            , walloc_(x.alloc_)
+            , begin_(NULL)
+            , size_(0)
+            , cap_(0)
+        {
+            if (x.size_ > 0) {
+                vallocate(words(x.size_));
+                std::memcpy(begin_, x.begin_, words(x.size_) * sizeof(word_type));
+                size_ = x.size_;
+            }
+        }
+
+        vector& operator=(const vector& x) {
+            if (this != &x) {
+                clear();
+                if (x.size_ > capacity()) {
+                    vdeallocate();
+                    vallocate(words(x.size_));
+                }
+                if (x.size_ > 0) {
+                    std::memcpy(begin_, x.begin_, words(x.size_) * sizeof(word_type));
+                }
+                size_ = x.size_;
+            }
+            return *this;
+        }
+
+#if __cplusplus >= 201103L
+        vector(vector&& x) noexcept
+            : alloc_(std::move(x.alloc_))
+            , walloc_(x.walloc_)
+            , begin_(x.begin_)
+            , size_(x.size_)
+            , cap_(x.cap_)
+        {
+            x.begin_ = NULL;
+            x.size_ = x.cap_ = 0;
+        }
+
+        vector& operator=(vector&& x) noexcept {
+            if (this != &x) {
+                vdeallocate();
+                alloc_ = std::move(x.alloc_);
+                walloc_ = x.walloc_;
+                begin_ = x.begin_;
+                size_ = x.size_;
+                cap_ = x.cap_;
+                x.begin_ = NULL;
+                x.size_ = x.cap_ = 0;
+            }
+            return *this;
+        }
+#endif
+
+        ~vector() {
+            vdeallocate();
+        }
+
+        iterator begin() { return iterator(begin_, 0); }
+        const_iterator begin() const { return const_iterator(begin_, 0); }
+        iterator end() { return begin() + size_; }
+        const_iterator end() const { return begin() + size_; }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        size_type size() const { return size_; }
+        size_type capacity() const { return cap_ * bits_per_word; }
+        size_type max_size() const {
+            size_type n = walloc_.max_size();
+            return n < std::numeric_limits<size_type>::max() / bits_per_word ? n * bits_per_word
+                                                                                : std::numeric_limits<difference_type>::max();
+        }
+        bool empty() const { return size_ == 0; }
+
+        void reserve(size_type n) {
+            if (n > capacity()) {
+                if (n > max_size()) {
+                    throw std::length_error("vector");
+                }
+                vreallocate(words(n));
+            }
+        }
+
+        void shrink_to_fit() {
+            if (cap_ > words(size_)) {
+                try {
+                    if (empty()) {
+                        vdeallocate();
+                    } else {
+                        vreallocate(words(size_));
+                    }
+                } catch (...) {
+                }
+            }
+        }
+
+        void resize(size_type n, value_type val = false) {
+            if (n > size_) {
+                if (n > capacity()) {
+                    reserve(recommend(n));
+                }
+                size_type sz = size_;
+                size_ = n;
+                fill(sz, n, val);
+            } else {
+                truncate(n);
+            }
+        }
+
+        reference operator[](size_type n) { return *(begin() + n); }
+        const_reference operator[](size_type n) const { return test(n); }
+
+        reference at(size_type n) {
+            if (n >= size_) {
+                throw std::out_of_range("vector");
+            }
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= size_) {
+                throw std::out_of_range("vector");
+            }
+            return test(n);
+        }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return test(0); }
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return test(size_ - 1); }
+
+        template <class InputIterator>
+        typename enable_if<!is_integral<InputIterator>::value, void>::type
+        assign(InputIterator first, InputIterator last) {
+            clear();
+            insert(end(), first, last);
+        }
+
+        void assign(size_type n, const value_type& val) {
+            clear();
+            resize(n, val);
+        }
+
+        void push_back(const value_type& val) {
+            if (size_ == capacity()) {
+                reserve(recommend(size_ + 1));
+            }
+            ++size_;
+            (*this)[size_ - 1] = val;
+        }
+
+        void pop_back() {
+            truncate(size_ - 1);
+        }
+
+        iterator insert(iterator position, const value_type& val) {
+            difference_type d = position - begin();
+            insert(position, 1, val);
+            return begin() + d;
+        }
+
+        void insert(iterator position, size_type n, const value_type& val) {
+            size_type d = static_cast<size_type>(position - begin());
+            open_gap(d, n);
+            fill(d, d + n, val);
+        }
+
+        template <class InputIterator>
+        typename enable_if<!is_integral<InputIterator>::value, void>::type
+        insert(iterator position, InputIterator first, InputIterator last) {
+            insert_range(static_cast<size_type>(position - begin()), first, last,
+                         typename iterator_traits<InputIterator>::iterator_category());
+        }
+
+        iterator erase(iterator position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(iterator first, iterator last) {
+            size_type d = static_cast<size_type>(first - begin());
+            truncate(static_cast<size_type>(std::copy(last, end(), first) - begin()));
+            return begin() + d;
+        }
+
+        void swap(vector& x) {
+            using std::swap;
+            swap(alloc_, x.alloc_);
+            swap(walloc_, x.walloc_);
+            std::swap(begin_, x.begin_);
+            std::swap(size_, x.size_);
+            std::swap(cap_, x.cap_);
+        }
+
+        static void swap(reference x, reference y) {
+            ft::swap(x, y);
+        }
+
+        void clear() {
+            if (begin_ != NULL) {
+                std::memset(begin_, 0, words(size_) * sizeof(word_type));
+            }
+            size_ = 0;
+        }
+
+        // Inverts every bit.
+        void flip() {
+            flip(0, size_);
+        }
+
+        // Sets or inverts the bits in [first, last).
+        void fill(size_type first, size_type last, bool val) {
+            for_each_mask(first, last, val ? set_bits : clear_bits);
+        }
+
+        void flip(size_type first, size_type last) {
+            for_each_mask(first, last, flip_bits);
+        }
+
+        // Number of set bits.
+        size_type count() const {
+            size_type n = 0;
+            for (size_type i = 0; i < words(size_); ++i) {
+                n += __builtin_popcountl(begin_[i]);
+            }
+            return n;
+        }
+
+        // Index of the first set bit, or size() if none.
+        size_type find_first() const {
+            return find_from(0);
+        }
+
+        // Index of the first set bit after pos, or size() if none.
+        size_type find_next(size_type pos) const {
+            return find_from(pos + 1);
+        }
+
+        // Word-wise logic with a vector of the same size; throws
+        // std::invalid_argument if the sizes differ.
+        vector& operator&=(const vector& x) {
+            check_same_size(x);
+            for (size_type i = 0; i < words(size_); ++i) {
+                begin_[i] &= x.begin_[i];
+            }
+            return *this;
+        }
+
+        vector& operator|=(const vector& x) {
+            check_same_size(x);
+            for (size_type i = 0; i < words(size_); ++i) {
+                begin_[i] |= x.begin_[i];
+            }
+            return *this;
+        }
+
+        vector& operator^=(const vector& x) {
+            check_same_size(x);
+            for (size_type i = 0; i < words(size_); ++i) {
+                begin_[i] ^= x.begin_[i];
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return alloc_;
+        }
+
+    protected:
+        static size_type words(size_type n) {
+            return (n + bits_per_word - 1) / bits_per_word;
+        }
+
+        void check_same_size(const vector& x) const {
+            if (x.size_ != size_) {
+                throw std::invalid_argument("vector");
+            }
+        }
+
+        bool test(size_type n) const {
+            return (begin_[n / bits_per_word] >> (n % bits_per_word)) & 1;
+        }
+
+        static void set_bits(word_type& w, word_type mask) { w |= mask; }
+        static void clear_bits(word_type& w, word_type mask) { w &= ~mask; }
+        static void flip_bits(word_type& w, word_type mask) { w ^= mask; }
+
+        // Applies op to [first, last) one word at a time, with partial masks
+        // only at the two ends.
+        void for_each_mask(size_type first, size_type last, void (*op)(word_type&, word_type)) {
+            while (first < last) {
+                size_type off = first % bits_per_word;
+                size_type n = std::min(bits_per_word - off, last - first);
+                word_type mask = n == bits_per_word ? ~static_cast<word_type>(0)
+                                                    : ((static_cast<word_type>(1) << n) - 1) << off;
+                op(begin_[first / bits_per_word], mask);
+                first += n;
+            }
+        }
+
+        size_type find_from(size_type pos) const {
+            if (pos >= size_) {
+                return size_;
+            }
+            size_type i = pos / bits_per_word;
+            word_type w = begin_[i] & (~static_cast<word_type>(0) << (pos % bits_per_word));
+            while (w == 0) {
+                if (++i == words(size_)) {
+                    return size_;
+                }
+                w = begin_[i];
+            }
+            return i * bits_per_word + __builtin_ctzl(w);
+        }
+
+        // Drops the bits from n on, clearing them in storage.
+        void truncate(size_type n) {
+            fill(n, size_, false);
+            size_ = n;
+        }
+
+        // Grows by n bits and moves [d, size()) up by n, leaving [d, d + n)
+        // to be written.
+        void open_gap(size_type d, size_type n) {
+            if (n == 0) {
+                return;
+            }
+            if (size_ + n > capacity()) {
+                reserve(recommend(size_ + n));
+            }
+            size_type sz = size_;
+            size_ += n;
+            std::copy_backward(begin() + d, begin() + sz, begin() + size_);
+        }
+
+        template <class InputIterator>
+        void insert_range(size_type d, InputIterator first, InputIterator last, std::input_iterator_tag) {
+            size_type sz = size_;
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+            std::rotate(begin() + d, begin() + sz, end());
+        }
+
+        template <class ForwardIterator>
+        void insert_range(size_type d, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+            open_gap(d, static_cast<size_type>(std::distance(first, last)));
+            std::copy(first, last, begin() + d);
+        }
+
+        size_type recommend(size_type n) const {
+            size_type ms = max_size();
+            if (n > ms) {
+                throw std::length_error("vector");
+            }
+            return vector_growth<value_type, allocator_type>::template recommend<word_type>(
+                       cap_, words(n), ms / bits_per_word) * bits_per_word;
+        }
+
+        void vallocate(size_type n) {
+            begin_ = walloc_.allocate(n);
+            std::memset(begin_, 0, n * sizeof(word_type));
+            cap_ = n;
+        }
+
+        void vreallocate(size_type n) {
+            word_type* p = walloc_.allocate(n);
+            std::memset(p, 0, n * sizeof(word_type));
+            if (begin_ != NULL) {
+                std::memcpy(p, begin_, words(size_) * sizeof(word_type));
+                walloc_.deallocate(begin_, cap_);
+            }
+            begin_ = p;
+            cap_ = n;
+        }
+
+        void vdeallocate() {
+            if (begin_ != NULL) {
+                walloc_.deallocate(begin_, cap_);
+                begin_ = NULL;
+                size_ = cap_ = 0;
+            }
+        }
+    };
+
 }